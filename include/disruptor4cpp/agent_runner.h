@@ -0,0 +1,199 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_AGENT_RUNNER_H_
+#define DISRUPTOR4CPP_AGENT_RUNNER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "idle_strategies/backoff_idle_strategy.h"
+
+namespace disruptor4cpp
+{
+	// Runs several processors on one thread: each pass calls process_available on every
+	// processor in turn, at most MaxEventsPerProcessor events each, and applies TIdleStrategy
+	// with the total. Give hot stages a dedicated thread (their own run() or runner) and let cold
+	// stages share a runner. Processors must be added before run and not be run elsewhere.
+	// A processor that halts while run is running, e.g. on a handler exception, is shut down and
+	// dropped from the remaining passes; the others keep running.
+	template <typename TIdleStrategy = backoff_idle_strategy<>, int MaxEventsPerProcessor = 256>
+	class agent_runner
+	{
+	public:
+		static_assert(MaxEventsPerProcessor > 0, "MaxEventsPerProcessor must be > 0");
+
+		agent_runner()
+			: running_(false),
+			  halted_(false)
+		{
+		}
+
+		~agent_runner() = default;
+
+		template <typename TProcessor>
+		void add(TProcessor& processor)
+		{
+			if (running_.load(std::memory_order_acquire))
+				throw std::runtime_error("Runner is already running");
+			agents_.push_back(agent { &processor, &start_processor<TProcessor>,
+				&process_available<TProcessor>, &is_processor_running<TProcessor>,
+				&shutdown_processor<TProcessor>, true });
+		}
+
+		std::size_t size() const
+		{
+			return agents_.size();
+		}
+
+		// One round-robin pass over the processors; returns the number of events processed.
+		int do_work()
+		{
+			int work_count = 0;
+			for (auto& a : agents_)
+			{
+				if (a.active)
+					work_count += a.process_available(a.processor, MaxEventsPerProcessor);
+			}
+			return work_count;
+		}
+
+		void run()
+		{
+			bool expected_running_state = false;
+			if (!running_.compare_exchange_strong(expected_running_state, true))
+				throw std::runtime_error("Thread is already running");
+
+			std::size_t started = 0;
+			try
+			{
+				for (; started < agents_.size(); started++)
+					agents_[started].start(agents_[started].processor);
+				idle_strategy_.reset();
+				while (!halted_.load(std::memory_order_acquire))
+				{
+					idle_strategy_.idle(do_work());
+					drop_halted();
+				}
+			}
+			catch (...)
+			{
+				shutdown(started);
+				throw;
+			}
+			shutdown(started);
+		}
+
+		// Makes run return after its current pass; may be called from any thread.
+		void halt()
+		{
+			halted_.store(true, std::memory_order_release);
+		}
+
+		bool is_running() const
+		{
+			return running_.load(std::memory_order_acquire);
+		}
+
+	private:
+		agent_runner(const agent_runner&) = delete;
+		agent_runner& operator=(const agent_runner&) = delete;
+		agent_runner(agent_runner&&) = delete;
+		agent_runner& operator=(agent_runner&&) = delete;
+
+		struct agent
+		{
+			void* processor;
+			void (*start)(void* processor);
+			int (*process_available)(void* processor, int max_events);
+			bool (*is_running)(void* processor);
+			void (*shutdown)(void* processor);
+			bool active;
+		};
+
+		template <typename TProcessor>
+		static void start_processor(void* processor)
+		{
+			static_cast<TProcessor*>(processor)->start();
+		}
+
+		template <typename TProcessor>
+		static int process_available(void* processor, int max_events)
+		{
+			return static_cast<TProcessor*>(processor)->process_available(max_events);
+		}
+
+		template <typename TProcessor>
+		static bool is_processor_running(void* processor)
+		{
+			return static_cast<TProcessor*>(processor)->is_running();
+		}
+
+		template <typename TProcessor>
+		static void shutdown_processor(void* processor)
+		{
+			static_cast<TProcessor*>(processor)->shutdown();
+		}
+
+		void drop_halted()
+		{
+			for (auto& a : agents_)
+			{
+				if (a.active && !a.is_running(a.processor))
+				{
+					a.active = false;
+					a.shutdown(a.processor);
+				}
+			}
+		}
+
+		void shutdown(std::size_t started)
+		{
+			for (std::size_t i = 0; i < started; i++)
+			{
+				if (agents_[i].active)
+					agents_[i].shutdown(agents_[i].processor);
+			}
+			for (auto& a : agents_)
+				a.active = true;
+			halted_.store(false, std::memory_order_release);
+			running_.store(false, std::memory_order_release);
+		}
+
+		std::vector<agent> agents_;
+		TIdleStrategy idle_strategy_;
+		std::atomic<bool> running_;
+		std::atomic<bool> halted_;
+	};
+}
+
+#endif
@@ -0,0 +1,229 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_AGGREGATE_EVENT_HANDLER_H_
+#define DISRUPTOR4CPP_AGGREGATE_EVENT_HANDLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "event_handler.h"
+
+namespace disruptor4cpp
+{
+	// Whether on_event of every handler is noexcept.
+	template <typename TEvent, typename... THandlers>
+	struct is_noexcept_aggregate : std::true_type
+	{
+	};
+
+	template <typename TEvent, typename THandler, typename... TRest>
+	struct is_noexcept_aggregate<TEvent, THandler, TRest...>
+		: std::integral_constant<bool, noexcept(std::declval<THandler&>().on_event(
+			std::declval<TEvent&>(), int64_t(), bool())) && is_noexcept_aggregate<TEvent, TRest...>::value>
+	{
+	};
+
+	// Calls several handlers, in order, on each event while it is still in cache, so that e.g.
+	// journaling, replication and business logic share one processor and thread. The handlers
+	// are held by their static types: declare them final, or use the aggregate as the
+	// processor's TEventHandler, and the calls can be inlined. Lifecycle callbacks go to every
+	// handler, and a handler failing to start or shut down only has its own exception callback
+	// called. An exception from on_event skips the remaining handlers for that event and is
+	// reported to all of them. on_event is noexcept when every handler's is, which lets a
+	// processor drop its exception handling.
+	template <typename TEvent, typename... THandlers>
+	class aggregate_event_handler final : public event_handler<TEvent>
+	{
+	public:
+		static_assert(sizeof...(THandlers) > 0, "Aggregate must have at least one handler");
+
+		explicit aggregate_event_handler(THandlers&... handlers)
+			: handlers_(handlers...)
+		{
+		}
+
+		virtual ~aggregate_event_handler() { }
+
+		virtual void on_start()
+		{
+			for_each(start_call());
+		}
+
+		virtual void on_shutdown()
+		{
+			for_each(shutdown_call());
+		}
+
+		virtual void on_event(TEvent& event, int64_t sequence, bool end_of_batch)
+			noexcept(is_noexcept_aggregate<TEvent, THandlers...>::value)
+		{
+			for_each(event_call { event, sequence, end_of_batch });
+		}
+
+		virtual void on_timeout(int64_t sequence)
+		{
+			for_each(timeout_call { sequence });
+		}
+
+		virtual void on_event_exception(const std::exception& ex, int64_t sequence, TEvent* event)
+		{
+			for_each(event_exception_call { ex, sequence, event });
+		}
+
+		virtual void on_start_exception(const std::exception& ex)
+		{
+			for_each(start_exception_call { ex });
+		}
+
+		virtual void on_shutdown_exception(const std::exception& ex)
+		{
+			for_each(shutdown_exception_call { ex });
+		}
+
+	private:
+		struct start_call
+		{
+			template <typename THandler>
+			void operator()(THandler& handler) const
+			{
+				try
+				{
+					handler.on_start();
+				}
+				catch (std::exception& ex)
+				{
+					handler.on_start_exception(ex);
+				}
+			}
+		};
+
+		struct shutdown_call
+		{
+			template <typename THandler>
+			void operator()(THandler& handler) const
+			{
+				try
+				{
+					handler.on_shutdown();
+				}
+				catch (std::exception& ex)
+				{
+					handler.on_shutdown_exception(ex);
+				}
+			}
+		};
+
+		struct event_call
+		{
+			TEvent& event;
+			int64_t sequence;
+			bool end_of_batch;
+
+			template <typename THandler>
+			void operator()(THandler& handler) const
+			{
+				handler.on_event(event, sequence, end_of_batch);
+			}
+		};
+
+		struct timeout_call
+		{
+			int64_t sequence;
+
+			template <typename THandler>
+			void operator()(THandler& handler) const
+			{
+				handler.on_timeout(sequence);
+			}
+		};
+
+		struct event_exception_call
+		{
+			const std::exception& ex;
+			int64_t sequence;
+			TEvent* event;
+
+			template <typename THandler>
+			void operator()(THandler& handler) const
+			{
+				handler.on_event_exception(ex, sequence, event);
+			}
+		};
+
+		struct start_exception_call
+		{
+			const std::exception& ex;
+
+			template <typename THandler>
+			void operator()(THandler& handler) const
+			{
+				handler.on_start_exception(ex);
+			}
+		};
+
+		struct shutdown_exception_call
+		{
+			const std::exception& ex;
+
+			template <typename THandler>
+			void operator()(THandler& handler) const
+			{
+				handler.on_shutdown_exception(ex);
+			}
+		};
+
+		template <typename TCall>
+		void for_each(const TCall& call)
+		{
+			for_each(call, std::integral_constant<std::size_t, 0>());
+		}
+
+		template <typename TCall, std::size_t I>
+		void for_each(const TCall& call, std::integral_constant<std::size_t, I>)
+		{
+			call(std::get<I>(handlers_));
+			for_each(call, std::integral_constant<std::size_t, I + 1>());
+		}
+
+		template <typename TCall>
+		void for_each(const TCall& call, std::integral_constant<std::size_t, sizeof...(THandlers)>)
+		{
+		}
+
+		std::tuple<THandlers&...> handlers_;
+	};
+}
+
+#endif
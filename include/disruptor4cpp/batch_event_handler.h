@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_BATCH_EVENT_HANDLER_H_
+#define DISRUPTOR4CPP_BATCH_EVENT_HANDLER_H_
+
+#include <cstdint>
+
+#include "event_handler.h"
+#include "strided_span.h"
+
+namespace disruptor4cpp
+{
+	// Opt-in handler receiving everything available to a batch_event_processor at once.
+	template <typename TEvent>
+	class batch_event_handler : public event_handler<TEvent>
+	{
+	public:
+		virtual ~batch_event_handler() { }
+
+		// Events [lo, lo + first.size() + second.size()) as at most two strided segments of the
+		// ring buffer, split where the batch wraps around the end of the buffer. second is empty
+		// unless the batch wraps. If it throws, on_event_exception is called with lo and a null event
+		// and the whole batch is considered processed, unless the exception handler halts the
+		// processor, in which case none of it is.
+		virtual void on_batch(strided_span<TEvent> first, strided_span<TEvent> second, int64_t lo) = 0;
+
+		// Processors that deliver events one by one hand them over as a single event batch.
+		virtual void on_event(TEvent& event, int64_t sequence, bool end_of_batch)
+		{
+			on_batch(strided_span<TEvent>(&event, 1), strided_span<TEvent>(), sequence);
+		}
+	};
+}
+
+#endif
@@ -35,36 +35,101 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
+#include "batch_event_handler.h"
 #include "event_handler.h"
+#include "exception_handlers/default_exception_handler.h"
+#include "exception_handlers/exception_action.h"
 #include "exceptions/alert_exception.h"
 #include "exceptions/timeout_exception.h"
 #include "sequence.h"
+#include "utils/tracepoint.h"
 
 namespace disruptor4cpp
 {
-	template <typename TRingBuffer>
+	// By default the processor owns the sequence it publishes its progress to. An external
+	// sequence can be passed instead, e.g. a consumer slot of a shared_ring_buffer, in which case
+	// processing resumes after the value it holds.
+	//
+	// Either run() it on a dedicated thread, or drive it from the caller's own loop with start(),
+	// process_available() and shutdown().
+	//
+	// TSequenceBarrier is the ring's default barrier type unless the barrier comes from
+	// new_barrier(std::array), which returns TRingBuffer::static_sequence_barrier_type<N>.
+	// TEventHandler defaults to the event_handler interface; a concrete (ideally final) handler
+	// type, such as an aggregate_event_handler, lets the handler calls be resolved statically.
+	// TExceptionHandler is the policy applied to exceptions thrown by the handler (see
+	// exception_handlers/); when the handler's on_event is noexcept, the batch loop has no
+	// exception handling at all.
+	template <typename TRingBuffer,
+		typename TSequenceBarrier = typename TRingBuffer::sequence_barrier_type,
+		typename TEventHandler = event_handler<typename TRingBuffer::event_type>,
+		typename TExceptionHandler = default_exception_handler>
 	class batch_event_processor
 	{
 	public:
+		// Batch handlers passed as a plain event_handler are detected by the overloads below;
+		// they only exist when TEventHandler is not itself a batch_event_handler, and take the
+		// handler in a non-deduced context so that the batch_event_handler base is always used.
 		batch_event_processor(TRingBuffer& ring_buffer,
-			typename TRingBuffer::sequence_barrier_type& sequence_barrier,
-			event_handler<typename TRingBuffer::event_type>& evt_handler)
-			: sequence_(),
+			TSequenceBarrier& sequence_barrier,
+			TEventHandler& evt_handler,
+			typename TRingBuffer::sequence_type* external_sequence = nullptr)
+			: own_sequence_(),
+			  sequence_(external_sequence != nullptr ? *external_sequence : own_sequence_),
 			  ring_buffer_(ring_buffer),
 			  sequence_barrier_(sequence_barrier),
 			  event_handler_(evt_handler),
+			  batch_event_handler_(as_batch_event_handler(evt_handler, is_batch_event_handler())),
 			  running_(false)
 		{
 		}
 
+		template <typename TBatchEventHandler = batch_event_handler<typename TRingBuffer::event_type>,
+			typename = typename std::enable_if<!std::is_base_of<TBatchEventHandler, TEventHandler>::value>::type>
 		batch_event_processor(TRingBuffer& ring_buffer,
-			std::unique_ptr<typename TRingBuffer::sequence_barrier_type> sequence_barrier_ptr,
-			event_handler<typename TRingBuffer::event_type>& evt_handler)
-			: sequence_(),
+			TSequenceBarrier& sequence_barrier,
+			typename std::enable_if<true, TBatchEventHandler>::type& evt_handler,
+			typename TRingBuffer::sequence_type* external_sequence = nullptr)
+			: own_sequence_(),
+			  sequence_(external_sequence != nullptr ? *external_sequence : own_sequence_),
+			  ring_buffer_(ring_buffer),
+			  sequence_barrier_(sequence_barrier),
+			  event_handler_(evt_handler),
+			  batch_event_handler_(&evt_handler),
+			  running_(false)
+		{
+		}
+
+		batch_event_processor(TRingBuffer& ring_buffer,
+			std::unique_ptr<TSequenceBarrier> sequence_barrier_ptr,
+			TEventHandler& evt_handler,
+			typename TRingBuffer::sequence_type* external_sequence = nullptr)
+			: own_sequence_(),
+			  sequence_(external_sequence != nullptr ? *external_sequence : own_sequence_),
 			  ring_buffer_(ring_buffer),
 			  sequence_barrier_(*sequence_barrier_ptr),
 			  event_handler_(evt_handler),
+			  batch_event_handler_(as_batch_event_handler(evt_handler, is_batch_event_handler())),
+			  sequence_barrier_ptr_(std::move(sequence_barrier_ptr)),
+			  running_(false)
+		{
+		}
+
+		template <typename TBatchEventHandler = batch_event_handler<typename TRingBuffer::event_type>,
+			typename = typename std::enable_if<!std::is_base_of<TBatchEventHandler, TEventHandler>::value>::type>
+		batch_event_processor(TRingBuffer& ring_buffer,
+			std::unique_ptr<TSequenceBarrier> sequence_barrier_ptr,
+			typename std::enable_if<true, TBatchEventHandler>::type& evt_handler,
+			typename TRingBuffer::sequence_type* external_sequence = nullptr)
+			: own_sequence_(),
+			  sequence_(external_sequence != nullptr ? *external_sequence : own_sequence_),
+			  ring_buffer_(ring_buffer),
+			  sequence_barrier_(*sequence_barrier_ptr),
+			  event_handler_(evt_handler),
+			  batch_event_handler_(&evt_handler),
 			  sequence_barrier_ptr_(std::move(sequence_barrier_ptr)),
 			  running_(false)
 		{
@@ -86,60 +151,181 @@ namespace disruptor4cpp
 			return running_.load(std::memory_order_acquire);
 		}
 
-		void run()
+		void start()
 		{
 			bool expected_running_state = false;
 			if (!running_.compare_exchange_strong(expected_running_state, true))
 				throw std::runtime_error("Thread is already running");
 
 			sequence_barrier_.clear_alert();
-			notify_start();
+			try
+			{
+				notify_start();
+			}
+			catch (...)
+			{
+				running_.store(false, std::memory_order_release);
+				throw;
+			}
+		}
 
-			typename TRingBuffer::event_type* event;
-			int64_t next_sequence = sequence_.get() + 1;
+		void shutdown()
+		{
+			try
+			{
+				notify_shutdown();
+			}
+			catch (...)
+			{
+				running_.store(false, std::memory_order_release);
+				throw;
+			}
+			running_.store(false, std::memory_order_release);
+		}
+
+		// Processes up to max_events already published events without waiting, and returns how
+		// many were processed. Must not be called while run() is running. Once halted, it
+		// processes nothing until the processor is started again.
+		int process_available(int max_events)
+		{
+			if (max_events < 1)
+				throw std::invalid_argument("max_events must be > 0");
+			if (sequence_barrier_.is_alerted())
+				return 0;
+
+			const int64_t next_sequence = sequence_.get_relaxed() + 1;
+			int64_t available_sequence = sequence_barrier_.get_available_sequence(next_sequence);
+			if (available_sequence < next_sequence)
+				return 0;
+			if (available_sequence - next_sequence >= max_events)
+				available_sequence = next_sequence + max_events - 1;
+			return static_cast<int>(process_batch(next_sequence, available_sequence) - next_sequence + 1);
+		}
+
+		void run()
+		{
+			start();
+
+			int64_t next_sequence = sequence_.get_relaxed() + 1;
 			try
 			{
 				while (true)
 				{
+					int64_t available_sequence;
 					try
 					{
-						const int64_t available_sequence = sequence_barrier_.wait_for(next_sequence);
-						while (next_sequence <= available_sequence)
-						{
-							event = &ring_buffer_[next_sequence];
-							event_handler_.on_event(*event, next_sequence, next_sequence == available_sequence);
-							next_sequence++;
-						}
-						sequence_.set(available_sequence);
+						available_sequence = sequence_barrier_.wait_for(next_sequence);
 					}
 					catch (timeout_exception& timeout_ex)
 					{
-						notify_timeout(sequence_.get());
+						notify_timeout(sequence_.get_relaxed());
+						continue;
 					}
 					catch (alert_exception& alert_ex)
 					{
 						if (!running_.load(std::memory_order_acquire))
 							break;
+						continue;
 					}
-					catch (std::exception& ex)
-					{
-						event_handler_.on_event_exception(ex, next_sequence, event);
-						sequence_.set(next_sequence);
-						next_sequence++;
-					}
+					next_sequence = process_batch(next_sequence, available_sequence) + 1;
 				}
 			}
 			catch (...)
 			{
-				notify_shutdown();
-				running_.store(false, std::memory_order_release);
+				shutdown();
 				throw;
 			}
-			notify_shutdown();
-			running_.store(false, std::memory_order_release);
+			shutdown();
 		}
 
 	private:
+		typedef std::is_base_of<batch_event_handler<typename TRingBuffer::event_type>, TEventHandler> is_batch_event_handler;
+		typedef std::integral_constant<bool, noexcept(std::declval<TEventHandler&>().on_event(
+			std::declval<typename TRingBuffer::event_type&>(), int64_t(), bool()))> is_noexcept_event_handler;
+
+		static batch_event_handler<typename TRingBuffer::event_type>* as_batch_event_handler(
+			TEventHandler& evt_handler, std::true_type)
+		{
+			return &evt_handler;
+		}
+
+		static batch_event_handler<typename TRingBuffer::event_type>* as_batch_event_handler(
+			TEventHandler& evt_handler, std::false_type)
+		{
+			return nullptr;
+		}
+
+		// Processes the events from lo to hi and publishes the progress; returns the last sequence
+		// processed, which is less than hi if the exception handler halted the processor. The
+		// event or batch that failed is then left unprocessed, so that a restart retries it.
+		int64_t process_batch(int64_t lo, int64_t hi)
+		{
+			DISRUPTOR4CPP_TRACE3(batch_begin, this, lo, hi);
+			if (lo <= hi)
+			{
+				hi = batch_event_handler_ != nullptr
+					? notify_batch(lo, hi) : process_events(lo, hi, is_noexcept_event_handler());
+			}
+			sequence_.set(hi);
+			DISRUPTOR4CPP_TRACE2(batch_end, this, hi);
+			return hi;
+		}
+
+		// The handler cannot throw, so the loop needs no exception handling at all.
+		int64_t process_events(int64_t lo, int64_t hi, std::true_type)
+		{
+			for (int64_t seq = lo; seq <= hi; seq++)
+				event_handler_.on_event(ring_buffer_[seq], seq, seq == hi);
+			return hi;
+		}
+
+		// The try block is entered once per batch rather than once per event; after an
+		// exception, processing resumes with the next event of the same batch.
+		int64_t process_events(int64_t lo, int64_t hi, std::false_type)
+		{
+			int64_t seq = lo;
+			while (true)
+			{
+				try
+				{
+					for (; seq <= hi; seq++)
+						event_handler_.on_event(ring_buffer_[seq], seq, seq == hi);
+					return hi;
+				}
+				catch (std::exception& ex)
+				{
+					sequence_.set(seq - 1);
+					if (exception_handler_.on_event_exception(ex, seq, &ring_buffer_[seq], event_handler_)
+						== exception_action::halt)
+					{
+						halt();
+						return seq - 1;
+					}
+					seq++;
+				}
+			}
+		}
+
+		int64_t notify_batch(int64_t lo, int64_t hi)
+		{
+			auto segments = ring_buffer_.get_segments(lo, hi);
+			try
+			{
+				batch_event_handler_->on_batch(segments.first, segments.second, lo);
+			}
+			catch (std::exception& ex)
+			{
+				sequence_.set(lo - 1);
+				if (exception_handler_.on_event_exception(ex, lo,
+					static_cast<typename TRingBuffer::event_type*>(nullptr), event_handler_) == exception_action::halt)
+				{
+					halt();
+					return lo - 1;
+				}
+			}
+			return hi;
+		}
+
 		void notify_timeout(int64_t available_sequence)
 		{
 			try
@@ -148,7 +334,9 @@ namespace disruptor4cpp
 			}
 			catch (std::exception& ex)
 			{
-				event_handler_.on_event_exception(ex, available_sequence, nullptr);
+				if (exception_handler_.on_event_exception(ex, available_sequence,
+					static_cast<typename TRingBuffer::event_type*>(nullptr), event_handler_) == exception_action::halt)
+					halt();
 			}
 		}
 
@@ -160,7 +348,7 @@ namespace disruptor4cpp
 			}
 			catch (std::exception& ex)
 			{
-				event_handler_.on_start_exception(ex);
+				exception_handler_.on_start_exception(ex, event_handler_);
 			}
 		}
 
@@ -172,15 +360,18 @@ namespace disruptor4cpp
 			}
 			catch (std::exception& ex)
 			{
-				event_handler_.on_shutdown_exception(ex);
+				exception_handler_.on_shutdown_exception(ex, event_handler_);
 			}
 		}
 
-		typename TRingBuffer::sequence_type sequence_;
+		typename TRingBuffer::sequence_type own_sequence_;
+		typename TRingBuffer::sequence_type& sequence_;
 		TRingBuffer& ring_buffer_;
-		typename TRingBuffer::sequence_barrier_type& sequence_barrier_;
-		event_handler<typename TRingBuffer::event_type>& event_handler_;
-		std::unique_ptr<typename TRingBuffer::sequence_barrier_type> sequence_barrier_ptr_;
+		TSequenceBarrier& sequence_barrier_;
+		TEventHandler& event_handler_;
+		batch_event_handler<typename TRingBuffer::event_type>* batch_event_handler_;
+		std::unique_ptr<TSequenceBarrier> sequence_barrier_ptr_;
+		TExceptionHandler exception_handler_;
 		std::atomic<bool> running_;
 	};
 }
@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_BATCHING_PUBLISHER_H_
+#define DISRUPTOR4CPP_BATCHING_PUBLISHER_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace disruptor4cpp
+{
+	// Write-combining publisher for a single producer thread, typically kept as a thread_local
+	// per producer of a multi producer ring buffer. Events are buffered locally and published
+	// BatchSize at a time with one next(n), one publish(lo, hi) and one wake up, instead of a
+	// claim, a publish and a wake up each.
+	//
+	// With a max_delay, the buffer is also flushed by the first publish made after the oldest
+	// buffered event has waited that long. Nothing flushes an idle publisher, so call flush when
+	// the thread runs out of work. The destructor flushes what is left.
+	template <typename TRingBuffer, std::size_t BatchSize>
+	class batching_publisher
+	{
+	public:
+		static_assert(BatchSize > 0, "BatchSize must be > 0");
+		static_assert(BatchSize <= TRingBuffer::BUFFER_SIZE, "BatchSize must not exceed the buffer size");
+
+		typedef typename TRingBuffer::event_type event_type;
+
+		static constexpr std::size_t BATCH_SIZE = BatchSize;
+
+		explicit batching_publisher(TRingBuffer& ring_buffer,
+			std::chrono::nanoseconds max_delay = std::chrono::nanoseconds::zero())
+			: ring_buffer_(ring_buffer),
+			  max_delay_(max_delay),
+			  count_(0)
+		{
+		}
+
+		~batching_publisher()
+		{
+			flush();
+		}
+
+		// Calls translator(event_type& event) on the next buffered event.
+		template <typename TTranslator>
+		void publish_event(TTranslator&& translator)
+		{
+			translator(events_[count_]);
+			buffered();
+		}
+
+		void publish(const event_type& event)
+		{
+			events_[count_] = event;
+			buffered();
+		}
+
+		void publish(event_type&& event)
+		{
+			events_[count_] = std::move(event);
+			buffered();
+		}
+
+		// Publishes the buffered events, if any.
+		void flush()
+		{
+			if (count_ == 0)
+				return;
+			const int64_t hi = ring_buffer_.next(static_cast<int>(count_));
+			const int64_t lo = hi - count_ + 1;
+			for (std::size_t i = 0; i < count_; i++)
+				ring_buffer_[lo + i] = std::move(events_[i]);
+			ring_buffer_.publish(lo, hi);
+			count_ = 0;
+		}
+
+		std::size_t size() const
+		{
+			return count_;
+		}
+
+	private:
+		batching_publisher(const batching_publisher&) = delete;
+		batching_publisher& operator=(const batching_publisher&) = delete;
+		batching_publisher(batching_publisher&&) = delete;
+		batching_publisher& operator=(batching_publisher&&) = delete;
+
+		void buffered()
+		{
+			if (++count_ == BatchSize)
+			{
+				flush();
+				return;
+			}
+			if (max_delay_ == std::chrono::nanoseconds::zero())
+				return;
+			const auto now = std::chrono::steady_clock::now();
+			if (count_ == 1)
+				oldest_time_ = now;
+			else if (now - oldest_time_ >= max_delay_)
+				flush();
+		}
+
+		TRingBuffer& ring_buffer_;
+		const std::chrono::nanoseconds max_delay_;
+		std::chrono::steady_clock::time_point oldest_time_;
+		std::size_t count_;
+		std::array<event_type, BatchSize> events_;
+	};
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_CLAIM_STRATEGY_H_
+#define DISRUPTOR4CPP_CLAIM_STRATEGY_H_
+
+namespace disruptor4cpp
+{
+	// How multi_producer_sequencer::next reserves sequences.
+	// compare_and_set: retries a CAS on the cursor once there is capacity for the range.
+	// fetch_add: reserves the range with one fetch_add on the cursor, then waits for capacity.
+	// try_next always uses compare_and_set, as it must not reserve a range it cannot fill.
+	//
+	// With fetch_add, the cursor covers a claim that is still waiting for capacity, so consumers
+	// see the sequence as claimed before it can be published. A blocking or lite_blocking wait
+	// strategy then returns at once instead of waiting on its condition, and the consumer spins
+	// on the availability of the sequence until the producer publishes it. Pair fetch_add with
+	// busy_spin or yielding waits, or size the buffer so that producers rarely wait for capacity.
+	enum class claim_strategy : int
+	{
+		compare_and_set,
+		fetch_add
+	};
+}
+
+#endif
@@ -0,0 +1,209 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_CONFLATING_RING_BUFFER_H_
+#define DISRUPTOR4CPP_CONFLATING_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "producer_type.h"
+#include "ring_buffer.h"
+#include "sequence.h"
+#include "utils/cache_line_storage.h"
+#include "utils/util.h"
+
+namespace disruptor4cpp
+{
+	// Latest-value-wins queue of keyed updates for a single consumer. Keys are dense indices in
+	// [0, KeyCapacity), e.g. instrument ids. Producers overwrite the value in the key's slot and
+	// publish the key into an ordinary ring buffer only when the slot becomes dirty, so a
+	// consumer that falls behind sees each updated key once, with its newest value, and catches
+	// up in O(keys) rather than O(updates).
+	//
+	// A key is in the ring at most once while dirty, plus once more while the consumer has taken
+	// it but not yet moved its sequence, so a ring of twice the key capacity never fills up.
+	template <typename TValue, std::size_t KeyCapacity, typename TWaitStrategy, producer_type ProducerType>
+	class conflating_ring_buffer
+	{
+	public:
+		static_assert(KeyCapacity > 0, "KeyCapacity must be > 0");
+
+		typedef TValue value_type;
+		typedef ring_buffer<std::size_t, util::next_power_of_two(2 * KeyCapacity),
+			TWaitStrategy, ProducerType> ring_buffer_type;
+
+		static constexpr std::size_t KEY_CAPACITY = KeyCapacity;
+
+		conflating_ring_buffer()
+			: ring_buffer_(),
+			  sequence_(),
+			  sequence_barrier_(ring_buffer_.new_barrier()),
+			  slots_()
+		{
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &sequence_ });
+		}
+
+		~conflating_ring_buffer() = default;
+
+		void publish(std::size_t key, const TValue& value)
+		{
+			check_key(key);
+			slot& target = slots_[key].data;
+			lock(target);
+			target.value = value;
+			const bool was_dirty = target.dirty;
+			target.dirty = true;
+			unlock(target);
+
+			if (!was_dirty)
+			{
+				int64_t seq = ring_buffer_.next();
+				ring_buffer_[seq] = key;
+				ring_buffer_.publish(seq);
+			}
+		}
+
+		// Calls handler(std::size_t key, const TValue& value) for every key published since the
+		// last call, with its latest value, without blocking. Returns the number of keys.
+		template <typename THandler>
+		int64_t poll(THandler&& handler)
+		{
+			const int64_t next_sequence = sequence_.get_relaxed() + 1;
+			const int64_t available_sequence =
+				ring_buffer_.get_highest_published_sequence(next_sequence, ring_buffer_.get_cursor());
+			return drain(next_sequence, available_sequence, handler);
+		}
+
+		// As poll, but first waits in the wait strategy for at least one key. Throws
+		// alert_exception once alert has been called.
+		template <typename THandler>
+		int64_t wait_and_poll(THandler&& handler)
+		{
+			const int64_t next_sequence = sequence_.get_relaxed() + 1;
+			return drain(next_sequence, sequence_barrier_->wait_for(next_sequence), handler);
+		}
+
+		void alert()
+		{
+			sequence_barrier_->alert();
+		}
+
+		void clear_alert()
+		{
+			sequence_barrier_->clear_alert();
+		}
+
+		ring_buffer_type& get_ring_buffer()
+		{
+			return ring_buffer_;
+		}
+
+	private:
+		conflating_ring_buffer(const conflating_ring_buffer&) = delete;
+		conflating_ring_buffer& operator=(const conflating_ring_buffer&) = delete;
+		conflating_ring_buffer(conflating_ring_buffer&&) = delete;
+		conflating_ring_buffer& operator=(conflating_ring_buffer&&) = delete;
+
+		struct slot
+		{
+			std::atomic<bool> locked;
+			bool dirty;
+			TValue value;
+		};
+
+		static void check_key(std::size_t key)
+		{
+			if (key >= KeyCapacity)
+				throw std::out_of_range("key must be < KeyCapacity");
+		}
+
+		static void lock(slot& target)
+		{
+			while (target.locked.exchange(true, std::memory_order_acquire))
+			{
+				while (target.locked.load(std::memory_order_relaxed))
+					std::this_thread::yield();
+			}
+		}
+
+		static void unlock(slot& target)
+		{
+			target.locked.store(false, std::memory_order_release);
+		}
+
+		template <typename THandler>
+		int64_t drain(int64_t next_sequence, int64_t available_sequence, THandler& handler)
+		{
+			TValue value;
+			int64_t count = 0;
+			for (int64_t seq = next_sequence; seq <= available_sequence; seq++)
+			{
+				const std::size_t key = ring_buffer_[seq];
+				slot& source = slots_[key].data;
+				lock(source);
+				const bool dirty = source.dirty;
+				source.dirty = false;
+				if (dirty)
+					value = source.value;
+				unlock(source);
+
+				if (dirty)
+				{
+					try
+					{
+						handler(key, static_cast<const TValue&>(value));
+					}
+					catch (...)
+					{
+						sequence_.set(seq);
+						throw;
+					}
+					++count;
+				}
+			}
+			if (available_sequence >= next_sequence)
+				sequence_.set(available_sequence);
+			return count;
+		}
+
+		ring_buffer_type ring_buffer_;
+		sequence sequence_;
+		std::unique_ptr<typename ring_buffer_type::sequence_barrier_type> sequence_barrier_;
+		cache_line_storage<slot> slots_[KeyCapacity];
+	};
+}
+
+#endif
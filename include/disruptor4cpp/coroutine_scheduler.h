@@ -0,0 +1,457 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_COROUTINE_SCHEDULER_H_
+#define DISRUPTOR4CPP_COROUTINE_SCHEDULER_H_
+
+// C++20 coroutine API, compiled only when the compiler supports coroutines; the rest of the
+// library keeps requiring C++11 only.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define DISRUPTOR4CPP_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef DISRUPTOR4CPP_HAS_COROUTINES
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "exceptions/alert_exception.h"
+#include "exceptions/insufficient_capacity_exception.h"
+#include "exceptions/timeout_exception.h"
+#include "idle_strategies/backoff_idle_strategy.h"
+#include "static_sequence_group.h"
+
+namespace disruptor4cpp
+{
+	// Coroutine spawned on a coroutine_scheduler. The scheduler owns the frame once spawned.
+	class consumer_task
+	{
+	public:
+		struct promise_type
+		{
+			consumer_task get_return_object()
+			{
+				return consumer_task(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			std::suspend_always initial_suspend() noexcept
+			{
+				return {};
+			}
+
+			// Suspends at the end, so that the scheduler sees done() and destroys the frame.
+			std::suspend_always final_suspend() noexcept
+			{
+				return {};
+			}
+
+			void return_void()
+			{
+			}
+
+			// Propagates to the scheduler's run or run_once.
+			void unhandled_exception()
+			{
+				throw;
+			}
+		};
+
+		consumer_task(consumer_task&& other) noexcept
+			: handle_(std::exchange(other.handle_, nullptr))
+		{
+		}
+
+		~consumer_task()
+		{
+			if (handle_)
+				handle_.destroy();
+		}
+
+		std::coroutine_handle<> release()
+		{
+			return std::exchange(handle_, nullptr);
+		}
+
+	private:
+		consumer_task(const consumer_task&) = delete;
+		consumer_task& operator=(const consumer_task&) = delete;
+		consumer_task& operator=(consumer_task&&) = delete;
+
+		explicit consumer_task(std::coroutine_handle<promise_type> handle)
+			: handle_(handle)
+		{
+		}
+
+		std::coroutine_handle<> handle_;
+	};
+
+	// Runs many consumer coroutines on the calling thread. A coroutine suspends in
+	// co_await next_batch(barrier, seq) until the barrier has events from seq, and is resumed by
+	// the scheduler once they are published. When no coroutine can make progress, the scheduler
+	// blocks in TWaitStrategy; so that publishing wakes it up, give the rings the same
+	// shared_wait_strategy<..., TTag> type and use it here as well.
+	//
+	// Producing coroutines suspend in co_await async_next(ring, n) while the ring is full. Consumer
+	// progress does not signal a wait strategy, so while such a coroutine waits the idle
+	// scheduler polls through TIdleStrategy instead of blocking. The default backs off from
+	// spinning to yielding to parking for up to a millisecond, which bounds both the CPU a full
+	// ring costs and the delay before a producer sees the freed capacity.
+	//
+	// The scheduler is not thread safe: spawn before run or from its coroutines, and use one
+	// scheduler per thread. Coroutines must await the scheduler's awaitables directly.
+	template <typename TWaitStrategy, typename TIdleStrategy = backoff_idle_strategy<>>
+	class coroutine_scheduler
+	{
+	public:
+		template <typename TSequenceBarrier>
+		class batch_awaitable
+		{
+		public:
+			batch_awaitable(coroutine_scheduler& scheduler, TSequenceBarrier& seq_barrier, int64_t seq)
+				: scheduler_(scheduler),
+				  sequence_barrier_(seq_barrier),
+				  sequence_(seq),
+				  available_sequence_(seq - 1)
+			{
+			}
+
+			bool await_ready()
+			{
+				return poll(this);
+			}
+
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				scheduler_.add_waiter(handle, &batch_awaitable::poll, this, true);
+			}
+
+			// The highest available sequence, >= the awaited one. Throws alert_exception if the
+			// barrier was alerted.
+			int64_t await_resume()
+			{
+				sequence_barrier_.check_alert();
+				return available_sequence_;
+			}
+
+		private:
+			static bool poll(void* awaitable)
+			{
+				batch_awaitable& self = *static_cast<batch_awaitable*>(awaitable);
+				self.available_sequence_ = self.sequence_barrier_.get_available_sequence(self.sequence_);
+				return self.available_sequence_ >= self.sequence_ || self.sequence_barrier_.is_alerted();
+			}
+
+			coroutine_scheduler& scheduler_;
+			TSequenceBarrier& sequence_barrier_;
+			int64_t sequence_;
+			int64_t available_sequence_;
+		};
+
+		template <typename TRingBuffer>
+		class claim_awaitable
+		{
+		public:
+			claim_awaitable(coroutine_scheduler& scheduler, TRingBuffer& ring, int n)
+				: scheduler_(scheduler),
+				  ring_buffer_(ring),
+				  n_(n),
+				  next_sequence_(-1)
+			{
+			}
+
+			bool await_ready()
+			{
+				return poll(this);
+			}
+
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				scheduler_.add_waiter(handle, &claim_awaitable::poll, this, false);
+			}
+
+			// The highest claimed sequence, as returned by next(n).
+			int64_t await_resume()
+			{
+				return next_sequence_;
+			}
+
+		private:
+			static bool poll(void* awaitable)
+			{
+				claim_awaitable& self = *static_cast<claim_awaitable*>(awaitable);
+				if (!self.ring_buffer_.has_available_capacity(self.n_))
+					return false;
+				try
+				{
+					// Only another producer claiming the capacity first makes this throw.
+					self.next_sequence_ = self.ring_buffer_.try_next(self.n_);
+					return true;
+				}
+				catch (insufficient_capacity_exception&)
+				{
+					return false;
+				}
+			}
+
+			coroutine_scheduler& scheduler_;
+			TRingBuffer& ring_buffer_;
+			int n_;
+			int64_t next_sequence_;
+		};
+
+		coroutine_scheduler()
+			: unsignalled_waiter_count_(0),
+			  pending_sequence_(*this),
+			  running_(false),
+			  alerted_(false)
+		{
+		}
+
+		~coroutine_scheduler()
+		{
+			for (auto handle : ready_)
+				handle.destroy();
+			for (auto& waiter : waiters_)
+				waiter.handle.destroy();
+		}
+
+		void spawn(consumer_task task)
+		{
+			ready_.push_back(task.release());
+		}
+
+		template <typename TSequenceBarrier>
+		batch_awaitable<TSequenceBarrier> next_batch(TSequenceBarrier& seq_barrier, int64_t seq)
+		{
+			return batch_awaitable<TSequenceBarrier>(*this, seq_barrier, seq);
+		}
+
+		template <typename TRingBuffer>
+		claim_awaitable<TRingBuffer> async_next(TRingBuffer& ring)
+		{
+			return async_next(ring, 1);
+		}
+
+		// Claims n slots like ring.next(n), suspending the coroutine while the ring is full.
+		template <typename TRingBuffer>
+		claim_awaitable<TRingBuffer> async_next(TRingBuffer& ring, int n)
+		{
+			if (n < 1 || static_cast<std::size_t>(n) > TRingBuffer::BUFFER_SIZE)
+				throw std::invalid_argument("n must be > 0 and <= buffer size");
+			return claim_awaitable<TRingBuffer>(*this, ring, n);
+		}
+
+		// Resumes every coroutine that can make progress; returns false if there was none.
+		bool run_once()
+		{
+			bool progressed = false;
+			for (std::size_t i = 0; i < waiters_.size();)
+			{
+				if (waiters_[i].poll(waiters_[i].awaitable))
+				{
+					if (!waiters_[i].signalled)
+						unsignalled_waiter_count_--;
+					ready_.push_back(waiters_[i].handle);
+					waiters_[i] = waiters_.back();
+					waiters_.pop_back();
+				}
+				else
+					i++;
+			}
+			while (!ready_.empty())
+			{
+				std::coroutine_handle<> handle = ready_.front();
+				ready_.pop_front();
+				progressed = true;
+				resume(handle);
+			}
+			return progressed;
+		}
+
+		// Runs until stop is called, blocking in the wait strategy when idle. A stop issued
+		// before run starts makes it return at once.
+		void run()
+		{
+			bool expected_running_state = false;
+			if (!running_.compare_exchange_strong(expected_running_state, true))
+				throw std::runtime_error("Scheduler is already running");
+
+			const static_sequence_group<pending_sequence, 1> pending_group =
+				static_sequence_group<pending_sequence, 1>::create(
+					std::array<const pending_sequence*, 1> { { &pending_sequence_ } });
+			try
+			{
+				while (!is_alerted())
+				{
+					if (run_once())
+					{
+						idle_strategy_.reset();
+						continue;
+					}
+					if (unsignalled_waiter_count_ > 0)
+					{
+						idle_strategy_.idle(0);
+						continue;
+					}
+					try
+					{
+						wait_strategy_.wait_for(0, pending_sequence_, pending_group, *this);
+					}
+					catch (timeout_exception&)
+					{
+					}
+					catch (alert_exception&)
+					{
+					}
+				}
+			}
+			catch (...)
+			{
+				running_.store(false, std::memory_order_release);
+				throw;
+			}
+			alerted_.store(false, std::memory_order_release);
+			running_.store(false, std::memory_order_release);
+		}
+
+		// Makes run return, or the next run if it has not started; may be called from any thread.
+		void stop()
+		{
+			alerted_.store(true, std::memory_order_release);
+			wait_strategy_.signal_all_when_blocking();
+		}
+
+		bool is_running() const
+		{
+			return running_.load(std::memory_order_acquire);
+		}
+
+		std::size_t get_waiting_count() const
+		{
+			return waiters_.size();
+		}
+
+		bool is_alerted() const
+		{
+			return alerted_.load(std::memory_order_acquire);
+		}
+
+		void check_alert() const
+		{
+			if (is_alerted())
+				throw alert_exception();
+		}
+
+	private:
+		coroutine_scheduler(const coroutine_scheduler&) = delete;
+		coroutine_scheduler& operator=(const coroutine_scheduler&) = delete;
+		coroutine_scheduler(coroutine_scheduler&&) = delete;
+		coroutine_scheduler& operator=(coroutine_scheduler&&) = delete;
+
+		struct waiter
+		{
+			std::coroutine_handle<> handle;
+			bool (*poll)(void* awaitable);
+			void* awaitable;
+			// Whether a publish signals the wait strategy when the waiter becomes ready.
+			bool signalled;
+		};
+
+		// Sequence-like view for the wait strategy: 0 once a coroutine can make progress.
+		class pending_sequence
+		{
+		public:
+			explicit pending_sequence(const coroutine_scheduler& scheduler)
+				: scheduler_(scheduler)
+			{
+			}
+
+			int64_t get() const
+			{
+				if (!scheduler_.ready_.empty())
+					return 0;
+				for (const auto& waiter : scheduler_.waiters_)
+				{
+					if (waiter.signalled && waiter.poll(waiter.awaitable))
+						return 0;
+				}
+				return -1;
+			}
+
+		private:
+			const coroutine_scheduler& scheduler_;
+		};
+
+		void add_waiter(std::coroutine_handle<> handle, bool (*poll)(void*), void* awaitable, bool signalled)
+		{
+			waiters_.push_back(waiter { handle, poll, awaitable, signalled });
+			if (!signalled)
+				unsignalled_waiter_count_++;
+		}
+
+		void resume(std::coroutine_handle<> handle)
+		{
+			try
+			{
+				handle.resume();
+			}
+			catch (...)
+			{
+				handle.destroy();
+				throw;
+			}
+			if (handle.done())
+				handle.destroy();
+		}
+
+		std::deque<std::coroutine_handle<>> ready_;
+		std::vector<waiter> waiters_;
+		std::size_t unsignalled_waiter_count_;
+		pending_sequence pending_sequence_;
+		TWaitStrategy wait_strategy_;
+		TIdleStrategy idle_strategy_;
+		std::atomic<bool> running_;
+		std::atomic<bool> alerted_;
+	};
+}
+
+#endif
+
+#endif
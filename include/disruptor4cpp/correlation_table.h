@@ -0,0 +1,151 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_CORRELATION_TABLE_H_
+#define DISRUPTOR4CPP_CORRELATION_TABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+#include "utils/cache_line_storage.h"
+
+namespace disruptor4cpp
+{
+	// Correlates responses with requests published to a request ring, using the request's
+	// sequence as the correlation id. The response side calls complete(seq, response); the
+	// requester either polls is_complete(seq) or wait(seq), or registers a callback with
+	// on_complete(seq, ...) before publishing the request, which complete then invokes on its
+	// thread. Slots are preallocated and indexed by seq & (Capacity - 1), so the slot of seq is
+	// reused by seq + Capacity: keep at most Capacity requests in flight, e.g. by making Capacity
+	// at least the request ring's size and taking each response before the ring wraps.
+	template <typename TResponse, std::size_t Capacity>
+	class correlation_table
+	{
+	public:
+		static_assert(std::is_default_constructible<TResponse>::value, "Response type must be default constructible");
+		static_assert((Capacity & (~Capacity + 1)) == Capacity, "Capacity must be a power of 2");
+
+		typedef TResponse response_type;
+		typedef void (*callback_type)(void* context, int64_t sequence, TResponse& response);
+
+		static constexpr std::size_t CAPACITY = Capacity;
+
+		correlation_table() = default;
+		~correlation_table() = default;
+
+		// Must happen before the request is published, so that complete sees the callback.
+		void on_complete(int64_t seq, callback_type callback, void* context)
+		{
+			slot& s = get_slot(seq);
+			s.callback = callback;
+			s.context = context;
+			s.callback_sequence = seq;
+		}
+
+		void complete(int64_t seq, const TResponse& response)
+		{
+			slot& s = get_slot(seq);
+			s.response = response;
+			if (s.callback_sequence == seq)
+				s.callback(s.context, seq, s.response);
+			else
+				s.completed_sequence.store(seq, std::memory_order_release);
+		}
+
+		bool is_complete(int64_t seq) const
+		{
+			return get_slot(seq).completed_sequence.load(std::memory_order_acquire) == seq;
+		}
+
+		// Only valid once is_complete(seq) returned true, until the slot is reused.
+		TResponse& get_response(int64_t seq)
+		{
+			return get_slot(seq).response;
+		}
+
+		// Spins, then yields, until the response of seq is complete.
+		template <int SpinTries = 100>
+		TResponse& wait(int64_t seq)
+		{
+			int counter = SpinTries;
+			while (!is_complete(seq))
+			{
+				if (counter == 0)
+					std::this_thread::yield();
+				else
+					--counter;
+			}
+			return get_response(seq);
+		}
+
+	private:
+		correlation_table(const correlation_table&) = delete;
+		correlation_table& operator=(const correlation_table&) = delete;
+		correlation_table(correlation_table&&) = delete;
+		correlation_table& operator=(correlation_table&&) = delete;
+
+		static constexpr int64_t INDEX_MASK = Capacity - 1;
+
+		// Cache line aligned, so that polling a slot does not contend with completing its neighbours.
+		struct alignas(CACHE_LINE_SIZE) slot
+		{
+			slot()
+				: completed_sequence(-1),
+				  callback_sequence(-1),
+				  callback(nullptr),
+				  context(nullptr)
+			{
+			}
+
+			std::atomic<int64_t> completed_sequence;
+			int64_t callback_sequence;
+			callback_type callback;
+			void* context;
+			TResponse response;
+		};
+
+		slot& get_slot(int64_t seq)
+		{
+			return slots_[seq & INDEX_MASK];
+		}
+
+		const slot& get_slot(int64_t seq) const
+		{
+			return slots_[seq & INDEX_MASK];
+		}
+
+		slot slots_[Capacity];
+	};
+}
+
+#endif
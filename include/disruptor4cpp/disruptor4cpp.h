@@ -34,19 +34,53 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "exceptions/alert_exception.h"
 #include "exceptions/insufficient_capacity_exception.h"
 #include "exceptions/timeout_exception.h"
+#include "agent_runner.h"
+#include "aggregate_event_handler.h"
+#include "batch_event_handler.h"
 #include "batch_event_processor.h"
+#include "batching_publisher.h"
+#include "conflating_ring_buffer.h"
+#include "coroutine_scheduler.h"
+#include "correlation_table.h"
 #include "event_handler.h"
+#include "exception_handlers/default_exception_handler.h"
+#include "exception_handlers/exception_action.h"
+#include "exception_handlers/fatal_exception_handler.h"
+#include "exception_handlers/halting_exception_handler.h"
+#include "exception_handlers/ignore_exception_handler.h"
+#include "idle_strategies/backoff_idle_strategy.h"
+#include "idle_strategies/busy_spin_idle_strategy.h"
+#include "idle_strategies/sleeping_idle_strategy.h"
+#include "idle_strategies/yielding_idle_strategy.h"
+#ifdef __linux__
+#include "journal/journal_event_handler.h"
+#include "journal/journal_replayer.h"
+#endif
 #include "no_op_event_processor.h"
+#include "offset_sequence_list.h"
+#include "pipeline.h"
+#include "priority_event_processor.h"
 #include "producer_type.h"
+#include "record_ring_buffer.h"
 #include "ring_buffer.h"
 #include "sequence_barrier.h"
 #include "sequence.h"
+#include "sharded_ring_buffer.h"
+#ifdef __linux__
+#include "shared_ring_buffer.h"
+#endif
+#include "strided_span.h"
 #include "wait_strategies/blocking_wait_strategy.h"
 #include "wait_strategies/busy_spin_wait_strategy.h"
+#ifdef __linux__
+#include "wait_strategies/futex_wait_strategy.h"
+#endif
 #include "wait_strategies/lite_blocking_wait_strategy.h"
 #include "wait_strategies/phased_backoff_wait_strategy.h"
+#include "wait_strategies/shared_wait_strategy.h"
 #include "wait_strategies/sleeping_wait_strategy.h"
 #include "wait_strategies/timeout_blocking_wait_strategy.h"
+#include "wait_strategies/wait_strategy_traits.h"
 #include "wait_strategies/yielding_wait_strategy.h"
 
 #endif
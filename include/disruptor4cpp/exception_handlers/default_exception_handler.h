@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_EXCEPTION_HANDLERS_DEFAULT_EXCEPTION_HANDLER_H_
+#define DISRUPTOR4CPP_EXCEPTION_HANDLERS_DEFAULT_EXCEPTION_HANDLER_H_
+
+#include <cstdint>
+#include <exception>
+
+#include "exception_action.h"
+
+namespace disruptor4cpp
+{
+	// Exception handlers are the policy a batch_event_processor applies to exceptions thrown by
+	// its event handler. This one reports them to the event handler's exception callbacks and
+	// resumes after the failing event.
+	class default_exception_handler
+	{
+	public:
+		default_exception_handler() = default;
+		~default_exception_handler() = default;
+
+		template <typename TEventHandler, typename TEvent>
+		exception_action on_event_exception(const std::exception& ex, int64_t sequence, TEvent* event,
+			TEventHandler& evt_handler)
+		{
+			evt_handler.on_event_exception(ex, sequence, event);
+			return exception_action::resume;
+		}
+
+		template <typename TEventHandler>
+		void on_start_exception(const std::exception& ex, TEventHandler& evt_handler)
+		{
+			evt_handler.on_start_exception(ex);
+		}
+
+		template <typename TEventHandler>
+		void on_shutdown_exception(const std::exception& ex, TEventHandler& evt_handler)
+		{
+			evt_handler.on_shutdown_exception(ex);
+		}
+
+	private:
+		default_exception_handler(const default_exception_handler&) = delete;
+		default_exception_handler& operator=(const default_exception_handler&) = delete;
+		default_exception_handler(default_exception_handler&&) = delete;
+		default_exception_handler& operator=(default_exception_handler&&) = delete;
+	};
+}
+
+#endif
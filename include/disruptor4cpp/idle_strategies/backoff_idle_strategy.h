@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_IDLE_STRATEGIES_BACKOFF_IDLE_STRATEGY_H_
+#define DISRUPTOR4CPP_IDLE_STRATEGIES_BACKOFF_IDLE_STRATEGY_H_
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace disruptor4cpp
+{
+	// Spins for MaxSpins idle passes, then yields for MaxYields, then parks for a period that
+	// doubles from MinParkNanoseconds up to MaxParkNanoseconds. Any work starts over with spinning.
+	template <int MaxSpins = 100, int MaxYields = 10,
+		int64_t MinParkNanoseconds = 1000, int64_t MaxParkNanoseconds = 1000000>
+	class backoff_idle_strategy
+	{
+	public:
+		static_assert(MinParkNanoseconds > 0 && MinParkNanoseconds <= MaxParkNanoseconds,
+			"Park period must be > 0 and MinParkNanoseconds <= MaxParkNanoseconds");
+
+		backoff_idle_strategy()
+			: spins_(0),
+			  yields_(0),
+			  park_period_nanoseconds_(MinParkNanoseconds)
+		{
+		}
+
+		~backoff_idle_strategy() = default;
+
+		void idle(int work_count)
+		{
+			if (work_count > 0)
+			{
+				reset();
+				return;
+			}
+			if (spins_ < MaxSpins)
+				spins_++;
+			else if (yields_ < MaxYields)
+			{
+				yields_++;
+				std::this_thread::yield();
+			}
+			else
+			{
+				std::this_thread::sleep_for(std::chrono::nanoseconds(park_period_nanoseconds_));
+				park_period_nanoseconds_ = park_period_nanoseconds_ * 2 < MaxParkNanoseconds
+					? park_period_nanoseconds_ * 2 : MaxParkNanoseconds;
+			}
+		}
+
+		void reset()
+		{
+			spins_ = 0;
+			yields_ = 0;
+			park_period_nanoseconds_ = MinParkNanoseconds;
+		}
+
+		int64_t get_park_period_nanoseconds() const
+		{
+			return park_period_nanoseconds_;
+		}
+
+	private:
+		backoff_idle_strategy(const backoff_idle_strategy&) = delete;
+		backoff_idle_strategy& operator=(const backoff_idle_strategy&) = delete;
+		backoff_idle_strategy(backoff_idle_strategy&&) = delete;
+		backoff_idle_strategy& operator=(backoff_idle_strategy&&) = delete;
+
+		int spins_;
+		int yields_;
+		int64_t park_period_nanoseconds_;
+	};
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_IDLE_STRATEGIES_BUSY_SPIN_IDLE_STRATEGY_H_
+#define DISRUPTOR4CPP_IDLE_STRATEGIES_BUSY_SPIN_IDLE_STRATEGY_H_
+
+namespace disruptor4cpp
+{
+	// Idle strategies are applied by a duty-cycle loop, such as agent_runner, after each pass
+	// with the amount of work the pass did; they only idle when it did none.
+	class busy_spin_idle_strategy
+	{
+	public:
+		busy_spin_idle_strategy() = default;
+		~busy_spin_idle_strategy() = default;
+
+		void idle(int work_count)
+		{
+		}
+
+		void reset()
+		{
+		}
+
+	private:
+		busy_spin_idle_strategy(const busy_spin_idle_strategy&) = delete;
+		busy_spin_idle_strategy& operator=(const busy_spin_idle_strategy&) = delete;
+		busy_spin_idle_strategy(busy_spin_idle_strategy&&) = delete;
+		busy_spin_idle_strategy& operator=(busy_spin_idle_strategy&&) = delete;
+	};
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_IDLE_STRATEGIES_YIELDING_IDLE_STRATEGY_H_
+#define DISRUPTOR4CPP_IDLE_STRATEGIES_YIELDING_IDLE_STRATEGY_H_
+
+#include <thread>
+
+namespace disruptor4cpp
+{
+	class yielding_idle_strategy
+	{
+	public:
+		yielding_idle_strategy() = default;
+		~yielding_idle_strategy() = default;
+
+		void idle(int work_count)
+		{
+			if (work_count == 0)
+				std::this_thread::yield();
+		}
+
+		void reset()
+		{
+		}
+
+	private:
+		yielding_idle_strategy(const yielding_idle_strategy&) = delete;
+		yielding_idle_strategy& operator=(const yielding_idle_strategy&) = delete;
+		yielding_idle_strategy(yielding_idle_strategy&&) = delete;
+		yielding_idle_strategy& operator=(yielding_idle_strategy&&) = delete;
+	};
+}
+
+#endif
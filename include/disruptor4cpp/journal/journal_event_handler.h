@@ -0,0 +1,191 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_JOURNAL_JOURNAL_EVENT_HANDLER_H_
+#define DISRUPTOR4CPP_JOURNAL_JOURNAL_EVENT_HANDLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "../event_handler.h"
+#include "../utils/mapped_file.h"
+#include "journal_format.h"
+#include "trivial_event_serializer.h"
+
+namespace disruptor4cpp
+{
+	// Appends every event to pre-allocated, memory mapped segment files in a directory and makes
+	// them durable with one msync per batch (group commit): a producer burst costs one sync
+	// however many events it holds. A new segment is started when the current one is full, and
+	// on construction after any segments already in the directory.
+	//
+	// A journal that failed to write cannot continue safely, so the exception hooks rethrow and
+	// stop the processor.
+	template <typename TEvent, typename TSerializer = trivial_event_serializer<TEvent>>
+	class journal_event_handler : public event_handler<TEvent>
+	{
+	public:
+		static constexpr std::size_t DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+
+		explicit journal_event_handler(const std::string& directory,
+			std::size_t segment_size = DEFAULT_SEGMENT_SIZE)
+			: directory_(directory),
+			  segment_size_(segment_size),
+			  segment_index_(0),
+			  write_offset_(0),
+			  synced_offset_(0),
+			  sync_count_(0)
+		{
+			if (segment_size < journal_format::SEGMENT_HEADER_LENGTH + journal_format::record_length(1))
+				throw std::invalid_argument("segment_size is too small");
+			auto segments = journal_format::list_segments(directory_);
+			open_segment(segments.empty() ? 0 : segments.back().first + 1);
+		}
+
+		virtual ~journal_event_handler() = default;
+
+		virtual void on_start()
+		{
+		}
+
+		virtual void on_shutdown()
+		{
+			sync();
+		}
+
+		virtual void on_event(TEvent& event, int64_t sequence, bool end_of_batch)
+		{
+			const std::size_t payload_length = TSerializer::size(event);
+			if (payload_length == 0)
+				throw std::invalid_argument("event serialized to an empty payload");
+			const std::size_t record_length = journal_format::record_length(payload_length);
+			if (record_length > segment_size_ - journal_format::SEGMENT_HEADER_LENGTH)
+				throw std::invalid_argument("event does not fit in a journal segment");
+			if (write_offset_ + record_length > segment_size_)
+			{
+				sync();
+				open_segment(segment_index_ + 1);
+			}
+
+			uint8_t* record = segment_->get_data() + write_offset_;
+			uint8_t* payload = record + journal_format::RECORD_HEADER_LENGTH;
+			TSerializer::write(event, payload);
+			journal_record_header header;
+			header.length = static_cast<uint32_t>(payload_length);
+			header.checksum = journal_format::checksum(sequence, payload, payload_length);
+			header.sequence = sequence;
+			std::memcpy(record, &header, sizeof(header));
+			write_offset_ += record_length;
+
+			if (end_of_batch)
+				sync();
+		}
+
+		virtual void on_timeout(int64_t sequence)
+		{
+		}
+
+		virtual void on_event_exception(const std::exception& ex, int64_t sequence, TEvent* event)
+		{
+			throw std::runtime_error(std::string("journal write failed: ") + ex.what());
+		}
+
+		virtual void on_start_exception(const std::exception& ex)
+		{
+			throw std::runtime_error(std::string("journal start failed: ") + ex.what());
+		}
+
+		virtual void on_shutdown_exception(const std::exception& ex)
+		{
+			throw std::runtime_error(std::string("journal shutdown failed: ") + ex.what());
+		}
+
+		// Writes back everything appended since the last sync.
+		void sync()
+		{
+			if (write_offset_ == synced_offset_)
+				return;
+			segment_->sync(synced_offset_, write_offset_ - synced_offset_);
+			synced_offset_ = write_offset_;
+			++sync_count_;
+		}
+
+		uint64_t get_segment_index() const
+		{
+			return segment_index_;
+		}
+
+		uint64_t get_sync_count() const
+		{
+			return sync_count_;
+		}
+
+	private:
+		journal_event_handler(const journal_event_handler&) = delete;
+		journal_event_handler& operator=(const journal_event_handler&) = delete;
+		journal_event_handler(journal_event_handler&&) = delete;
+		journal_event_handler& operator=(journal_event_handler&&) = delete;
+
+		void open_segment(uint64_t index)
+		{
+			std::unique_ptr<mapped_file> segment(new mapped_file(
+				mapped_file::create(journal_format::segment_path(directory_, index), segment_size_)));
+			mapped_file::sync_directory(directory_);
+
+			journal_segment_header header = {};
+			header.magic = journal_format::MAGIC;
+			header.version = journal_format::VERSION;
+			header.header_length = journal_format::SEGMENT_HEADER_LENGTH;
+			header.segment_index = index;
+			header.segment_size = segment_size_;
+			std::memcpy(segment->get_data(), &header, sizeof(header));
+
+			segment_ = std::move(segment);
+			segment_index_ = index;
+			write_offset_ = journal_format::SEGMENT_HEADER_LENGTH;
+			synced_offset_ = 0;
+		}
+
+		std::string directory_;
+		std::size_t segment_size_;
+		std::unique_ptr<mapped_file> segment_;
+		uint64_t segment_index_;
+		std::size_t write_offset_;
+		std::size_t synced_offset_;
+		uint64_t sync_count_;
+	};
+}
+
+#endif
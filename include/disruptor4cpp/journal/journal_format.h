@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_JOURNAL_JOURNAL_FORMAT_H_
+#define DISRUPTOR4CPP_JOURNAL_JOURNAL_FORMAT_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+
+#include "../utils/crc32c.h"
+
+namespace disruptor4cpp
+{
+	// Each segment file starts with this header, padded to SEGMENT_HEADER_LENGTH bytes.
+	struct journal_segment_header
+	{
+		uint64_t magic;
+		uint32_t version;
+		uint32_t header_length;
+		uint64_t segment_index;
+		uint64_t segment_size;
+	};
+
+	// Followed by the payload, padded to RECORD_ALIGNMENT. A zero length marks the end of the
+	// written part of a pre-allocated segment, so a record always has a payload of at least one
+	// byte.
+	struct journal_record_header
+	{
+		uint32_t length;
+		uint32_t checksum;
+		int64_t sequence;
+	};
+
+	// Layout of a journal directory: segment files named by their zero padded index, each a
+	// header followed by records. The record checksum is the CRC-32C of the sequence and the
+	// payload, so that a torn write at the tail is detected on replay.
+	class journal_format
+	{
+	public:
+		static constexpr uint64_t MAGIC = 0x314c4e524a433444ULL; // "D4CJRNL1"
+		static constexpr uint32_t VERSION = 1;
+		static constexpr std::size_t SEGMENT_HEADER_LENGTH = 64;
+		static constexpr std::size_t RECORD_HEADER_LENGTH = sizeof(journal_record_header);
+		static constexpr std::size_t RECORD_ALIGNMENT = 8;
+
+		static std::size_t record_length(std::size_t payload_length)
+		{
+			return (RECORD_HEADER_LENGTH + payload_length + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+		}
+
+		static uint32_t checksum(int64_t seq, const uint8_t* payload, std::size_t length)
+		{
+			return crc32c::update(crc32c::compute(&seq, sizeof(seq)), payload, length);
+		}
+
+		static std::string segment_path(const std::string& directory, uint64_t index)
+		{
+			char name[32];
+			std::snprintf(name, sizeof(name), "%020llu.journal", static_cast<unsigned long long>(index));
+			return directory + "/" + name;
+		}
+
+		// The segment files of a directory as (index, path), in index order.
+		static std::vector<std::pair<uint64_t, std::string>> list_segments(const std::string& directory)
+		{
+			DIR* dir = ::opendir(directory.c_str());
+			if (dir == nullptr)
+				throw std::system_error(errno, std::system_category(), "opendir");
+
+			std::vector<std::pair<uint64_t, std::string>> segments;
+			while (struct dirent* entry = ::readdir(dir))
+			{
+				const std::string name(entry->d_name);
+				static const std::string suffix(".journal");
+				if (name.size() != 20 + suffix.size() || name.compare(20, suffix.size(), suffix) != 0
+					|| name.find_first_not_of("0123456789") != 20)
+					continue;
+				segments.push_back(std::make_pair(std::strtoull(name.c_str(), nullptr, 10), directory + "/" + name));
+			}
+			::closedir(dir);
+			std::sort(segments.begin(), segments.end());
+			return segments;
+		}
+
+	private:
+		static_assert(sizeof(journal_segment_header) <= SEGMENT_HEADER_LENGTH, "Segment header too large");
+		static_assert(sizeof(journal_record_header) % RECORD_ALIGNMENT == 0, "Record header must keep alignment");
+	};
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_JOURNAL_JOURNAL_REPLAYER_H_
+#define DISRUPTOR4CPP_JOURNAL_JOURNAL_REPLAYER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include "../utils/mapped_file.h"
+#include "journal_format.h"
+#include "trivial_event_serializer.h"
+
+namespace disruptor4cpp
+{
+	// Publishes the events of a journal written by journal_event_handler into a ring buffer, in
+	// journal order, before live traffic starts. Segments are mapped read only with sequential
+	// access and readahead hints, records are claimed in batches with next(n) and copied straight
+	// into the slots, and a record with a bad checksum (a torn write at the tail of the segment
+	// being written at the time of a crash) ends that segment.
+	//
+	// Replaying a complete journal into a fresh ring buffer reproduces the journaled sequences,
+	// so that the live stream continues from the replayed point. The replayer remembers the
+	// journal position it reached rather than the sequence, so a later replay publishes only the
+	// records appended since, and a journal whose sequences restart (a process that started
+	// without replaying) is replayed in full.
+	template <typename TEvent, typename TSerializer = trivial_event_serializer<TEvent>>
+	class journal_replayer
+	{
+	public:
+		explicit journal_replayer(const std::string& directory)
+			: directory_(directory),
+			  last_journal_sequence_(-1),
+			  next_segment_index_(0),
+			  next_offset_(journal_format::SEGMENT_HEADER_LENGTH)
+		{
+		}
+
+		~journal_replayer() = default;
+
+		// Returns the number of events published. The sequences in replayed_sequences belong to
+		// processors that must not see the replayed events again, typically the journaler; they
+		// must not be running yet, and are moved past every published batch, so that they
+		// neither handle nor gate the replay. Other processors may already be running and
+		// consume the replay like live events.
+		template <typename TRingBuffer>
+		int64_t replay(TRingBuffer& ring_buffer,
+			const std::vector<typename TRingBuffer::sequence_type*>& replayed_sequences
+				= std::vector<typename TRingBuffer::sequence_type*>(),
+			int batch_size = TRingBuffer::BUFFER_SIZE)
+		{
+			if (batch_size < 1)
+				throw std::invalid_argument("batch_size must be > 0");
+			if (batch_size > static_cast<int>(TRingBuffer::BUFFER_SIZE))
+				batch_size = TRingBuffer::BUFFER_SIZE;
+
+			int64_t replayed = 0;
+			std::vector<const journal_record_header*> batch;
+			batch.reserve(batch_size);
+			for (const auto& segment_entry : journal_format::list_segments(directory_))
+			{
+				if (segment_entry.first < next_segment_index_)
+					continue;
+				if (segment_entry.first > next_segment_index_)
+				{
+					next_segment_index_ = segment_entry.first;
+					next_offset_ = journal_format::SEGMENT_HEADER_LENGTH;
+				}
+
+				mapped_file segment = mapped_file::open_read_only(segment_entry.second);
+				segment.advise(MADV_SEQUENTIAL);
+				segment.advise(MADV_WILLNEED);
+				check_segment(segment);
+
+				const journal_record_header* record;
+				while ((record = next_record(segment, next_offset_)) != nullptr)
+				{
+					next_offset_ += journal_format::record_length(record->length);
+					last_journal_sequence_ = record->sequence;
+					batch.push_back(record);
+					if (batch.size() == static_cast<std::size_t>(batch_size))
+						replayed += publish(ring_buffer, batch, replayed_sequences);
+				}
+				replayed += publish(ring_buffer, batch, replayed_sequences);
+			}
+			return replayed;
+		}
+
+		// The sequence of the last journaled event replayed, or -1.
+		int64_t get_last_journal_sequence() const
+		{
+			return last_journal_sequence_;
+		}
+
+	private:
+		journal_replayer(const journal_replayer&) = delete;
+		journal_replayer& operator=(const journal_replayer&) = delete;
+		journal_replayer(journal_replayer&&) = delete;
+		journal_replayer& operator=(journal_replayer&&) = delete;
+
+		static void check_segment(const mapped_file& segment)
+		{
+			journal_segment_header header;
+			if (segment.get_size() < journal_format::SEGMENT_HEADER_LENGTH)
+				throw std::runtime_error("journal segment is truncated: " + segment.get_path());
+			std::memcpy(&header, segment.get_data(), sizeof(header));
+			if (header.magic != journal_format::MAGIC || header.version != journal_format::VERSION)
+				throw std::runtime_error("journal segment has an unknown format: " + segment.get_path());
+		}
+
+		// The record at offset, or nullptr at the end of the written part of the segment.
+		static const journal_record_header* next_record(const mapped_file& segment, std::size_t offset)
+		{
+			if (offset + journal_format::RECORD_HEADER_LENGTH > segment.get_size())
+				return nullptr;
+			const journal_record_header* record
+				= reinterpret_cast<const journal_record_header*>(segment.get_data() + offset);
+			if (record->length == 0
+				|| offset + journal_format::record_length(record->length) > segment.get_size())
+				return nullptr;
+			const uint8_t* payload = segment.get_data() + offset + journal_format::RECORD_HEADER_LENGTH;
+			if (journal_format::checksum(record->sequence, payload, record->length) != record->checksum)
+				return nullptr;
+			return record;
+		}
+
+		template <typename TRingBuffer>
+		static int64_t publish(TRingBuffer& ring_buffer, std::vector<const journal_record_header*>& batch,
+			const std::vector<typename TRingBuffer::sequence_type*>& replayed_sequences)
+		{
+			if (batch.empty())
+				return 0;
+
+			const int count = static_cast<int>(batch.size());
+			const int64_t hi = ring_buffer.next(count);
+			const int64_t lo = hi - count + 1;
+			for (int i = 0; i < count; i++)
+			{
+				const uint8_t* payload = reinterpret_cast<const uint8_t*>(batch[i]) + journal_format::RECORD_HEADER_LENGTH;
+				TSerializer::read(payload, batch[i]->length, ring_buffer[lo + i]);
+			}
+			ring_buffer.publish(lo, hi);
+			for (auto seq : replayed_sequences)
+				seq->set(hi);
+			batch.clear();
+			return count;
+		}
+
+		std::string directory_;
+		int64_t last_journal_sequence_;
+		uint64_t next_segment_index_;
+		std::size_t next_offset_;
+	};
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_JOURNAL_TRIVIAL_EVENT_SERIALIZER_H_
+#define DISRUPTOR4CPP_JOURNAL_TRIVIAL_EVENT_SERIALIZER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace disruptor4cpp
+{
+	// Journals an event as its object representation. A custom serializer provides the same
+	// three static functions for events that are not trivially copyable.
+	template <typename TEvent>
+	struct trivial_event_serializer
+	{
+		static_assert(std::is_trivially_copyable<TEvent>::value,
+			"Event type must be trivially copyable, or provide a serializer");
+
+		static std::size_t size(const TEvent& event)
+		{
+			return sizeof(TEvent);
+		}
+
+		static void write(const TEvent& event, uint8_t* buffer)
+		{
+			std::memcpy(buffer, &event, sizeof(TEvent));
+		}
+
+		static void read(const uint8_t* buffer, std::size_t length, TEvent& event)
+		{
+			if (length != sizeof(TEvent))
+				throw std::runtime_error("journal record does not match the event size");
+			std::memcpy(&event, buffer, sizeof(TEvent));
+		}
+	};
+}
+
+#endif
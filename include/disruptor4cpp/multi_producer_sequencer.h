@@ -32,31 +32,46 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DISRUPTOR4CPP_MULTI_PRODUCER_SEQUENCER_H_
 
 #include <cstddef>
+#include <array>
+#include <atomic>
 #include <cstdint>
-#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+#include "claim_strategy.h"
 #include "exceptions/insufficient_capacity_exception.h"
 #include "sequence.h"
 #include "sequence_barrier.h"
+#include "static_sequence_group.h"
+#include "utils/cache_line_storage.h"
+#include "utils/tracepoint.h"
 #include "utils/util.h"
 
 namespace disruptor4cpp
 {
-	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence = sequence>
+	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence = sequence,
+		typename TGatingSequences = std::vector<TSequence*>,
+		claim_strategy ClaimStrategy = claim_strategy::compare_and_set>
 	class multi_producer_sequencer
 	{
 	public:
 		typedef TWaitStrategy wait_strategy_type;
 		typedef TSequence sequence_type;
+		typedef TGatingSequences gating_sequences_type;
 		typedef sequence_barrier<
-			multi_producer_sequencer<BufferSize, TWaitStrategy, TSequence>> sequence_barrier_type;
+			multi_producer_sequencer<BufferSize, TWaitStrategy, TSequence,
+				TGatingSequences, ClaimStrategy>> sequence_barrier_type;
+		template <std::size_t N>
+		using static_sequence_barrier_type = sequence_barrier<
+			multi_producer_sequencer<BufferSize, TWaitStrategy, TSequence,
+				TGatingSequences, ClaimStrategy>, static_sequence_group<TSequence, N>>;
 
 		static constexpr int64_t INITIAL_CURSOR_VALUE = -1;
 		static constexpr std::size_t BUFFER_SIZE = BufferSize;
+		static constexpr claim_strategy CLAIM_STRATEGY = ClaimStrategy;
 
 		multi_producer_sequencer()
 			: cursor_(),
@@ -64,7 +79,8 @@ namespace disruptor4cpp
 			  wait_strategy_(),
 			  gating_sequences_()
 		{
-			std::memset(available_buffer_, ~0, sizeof(available_buffer_));
+			for (auto& flag : available_buffer_)
+				flag.store(-1, std::memory_order_relaxed);
 		}
 
 		~multi_producer_sequencer() = default;
@@ -81,7 +97,7 @@ namespace disruptor4cpp
 
 		TWaitStrategy& get_wait_strategy()
 		{
-			return wait_strategy_;
+			return wait_strategy_.data;
 		}
 
 		void add_gating_sequences(const std::vector<TSequence*>& sequences_to_add)
@@ -127,7 +143,16 @@ namespace disruptor4cpp
 		std::unique_ptr<sequence_barrier_type> new_barrier(const std::vector<TSequence*>& sequences_to_track)
 		{
 			return std::unique_ptr<sequence_barrier_type>(
-				new sequence_barrier_type(*this, wait_strategy_, cursor_, sequences_to_track));
+				new sequence_barrier_type(*this, wait_strategy_.data, cursor_, sequences_to_track));
+		}
+
+		// Barrier over dependencies fixed at compile time, which waits without pointer chasing.
+		template <std::size_t N>
+		std::unique_ptr<static_sequence_barrier_type<N>> new_barrier(const std::array<TSequence*, N>& sequences_to_track)
+		{
+			return std::unique_ptr<static_sequence_barrier_type<N>>(
+				new static_sequence_barrier_type<N>(*this, wait_strategy_.data, cursor_,
+					static_sequence_group<TSequence, N>::create(sequences_to_track)));
 		}
 
 		bool has_available_capacity(int required_capacity)
@@ -145,29 +170,8 @@ namespace disruptor4cpp
 			if (n < 1)
 				throw std::invalid_argument("n must be > 0");
 
-			int64_t current;
-			int64_t next;
-			do
-			{
-				current = cursor_.get();
-				next = current + n;
-
-				int64_t wrap_point = next - BufferSize;
-				int64_t cached_gating_sequence = gating_sequence_cache_.get();
-				if (wrap_point > cached_gating_sequence || cached_gating_sequence > current)
-				{
-					int64_t gating_sequence = util::get_minimum_sequence(gating_sequences_, current);
-					if (wrap_point > gating_sequence)
-					{
-						std::this_thread::yield();
-						continue;
-					}
-					gating_sequence_cache_.set(gating_sequence);
-				}
-				else if (cursor_.compare_and_set(current, next))
-					break;
-			}
-			while (true);
+			int64_t next = claim_next(n, std::integral_constant<claim_strategy, ClaimStrategy>());
+			DISRUPTOR4CPP_TRACE3(claim, this, next - n + 1, next);
 			return next;
 		}
 
@@ -185,20 +189,23 @@ namespace disruptor4cpp
 			int64_t next;
 			do
 			{
-				current = cursor_.get();
+				current = cursor_.get_relaxed();
 				next = current + n;
 				if (!has_available_capacity(n, current))
 					throw insufficient_capacity_exception();
 			}
-			while (!cursor_.compare_and_set(current, next));
+			while (!cursor_.compare_and_set(current, next, std::memory_order_relaxed));
+			DISRUPTOR4CPP_TRACE3(claim, this, next - n + 1, next);
 			return next;
 		}
 
+		// With claim_strategy::fetch_add, producers waiting for capacity hold reservations beyond
+		// the buffer, and the capacity is reported as 0 until the consumers free all of them.
 		int64_t remaining_capacity() const
 		{
 			int64_t consumed = util::get_minimum_sequence(gating_sequences_, cursor_.get());
 			int64_t produced = cursor_.get();
-			return BufferSize - (produced - consumed);
+			return produced - consumed < static_cast<int64_t>(BufferSize) ? BufferSize - (produced - consumed) : 0;
 		}
 
 		void claim(int64_t seq)
@@ -209,7 +216,8 @@ namespace disruptor4cpp
 		void publish(int64_t seq)
 		{
 			set_available(seq);
-			wait_strategy_.signal_all_when_blocking();
+			DISRUPTOR4CPP_TRACE3(publish, this, seq, seq);
+			wait_strategy_.data.signal_all_when_blocking();
 		}
 
 		void publish(int64_t lo, int64_t hi)
@@ -218,14 +226,15 @@ namespace disruptor4cpp
 			{
 				set_available(i);
 			}
-			wait_strategy_.signal_all_when_blocking();
+			DISRUPTOR4CPP_TRACE3(publish, this, lo, hi);
+			wait_strategy_.data.signal_all_when_blocking();
 		}
 
 		bool is_available(int64_t seq) const
 		{
 			int index = calculate_index(seq);
 			int flag = calculate_availability_flag(seq);
-			return available_buffer_[index] == flag;
+			return available_buffer_[index].load(std::memory_order_acquire) == flag;
 		}
 
 		int64_t get_highest_published_sequence(int64_t lower_bound, int64_t available_sequence) const
@@ -247,7 +256,60 @@ namespace disruptor4cpp
 		static constexpr int INDEX_MASK = BufferSize - 1;
 		static constexpr int INDEX_SHIFT = util::log2(BufferSize);
 
-		bool has_available_capacity(int required_capacity, int cursor_value)
+		int64_t claim_next(int n, std::integral_constant<claim_strategy, claim_strategy::compare_and_set>)
+		{
+			// The cursor only serves as the claim counter here: consumers synchronize on the
+			// availability buffer and the wrap check acquires the gating sequences, so the
+			// claim itself needs no ordering.
+			int64_t current;
+			int64_t next;
+			do
+			{
+				current = cursor_.get_relaxed();
+				next = current + n;
+
+				int64_t wrap_point = next - BufferSize;
+				int64_t cached_gating_sequence = gating_sequence_cache_.get();
+				if (wrap_point > cached_gating_sequence || cached_gating_sequence > current)
+				{
+					int64_t gating_sequence = util::get_minimum_sequence(gating_sequences_, current);
+					if (wrap_point > gating_sequence)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+					gating_sequence_cache_.set(gating_sequence);
+				}
+				else if (cursor_.compare_and_set(current, next, std::memory_order_relaxed))
+					break;
+			}
+			while (true);
+			return next;
+		}
+
+		// The range is reserved unconditionally, so each producer makes exactly one atomic
+		// operation on the cursor however contended it is. Until the consumers free the range,
+		// the cursor may run ahead of the buffer; consumers still wait on the availability buffer,
+		// and spin on it rather than block in the wait strategy (see claim_strategy).
+		int64_t claim_next(int n, std::integral_constant<claim_strategy, claim_strategy::fetch_add>)
+		{
+			const int64_t next = cursor_.add_and_get(n, std::memory_order_relaxed);
+			const int64_t current = next - n;
+			const int64_t wrap_point = next - BufferSize;
+			int64_t cached_gating_sequence = gating_sequence_cache_.get();
+			if (wrap_point > cached_gating_sequence || cached_gating_sequence > current)
+			{
+				int64_t gating_sequence;
+				while (wrap_point > (gating_sequence = util::get_minimum_sequence(gating_sequences_, current)))
+				{
+					std::this_thread::yield();
+				}
+				gating_sequence_cache_.set(gating_sequence);
+			}
+			return next;
+		}
+
+		bool has_available_capacity(int required_capacity, int64_t cursor_value)
 		{
 			int64_t wrap_point = (cursor_value + required_capacity) - BufferSize;
 			int64_t cached_gating_sequence = gating_sequence_cache_.get();
@@ -265,7 +327,7 @@ namespace disruptor4cpp
 		{
 			int index = calculate_index(seq);
 			int flag = calculate_availability_flag(seq);
-			available_buffer_[index] = flag;
+			available_buffer_[index].store(flag, std::memory_order_release);
 		}
 
 		int calculate_availability_flag(int64_t seq) const
@@ -280,9 +342,9 @@ namespace disruptor4cpp
 
 		TSequence cursor_;
 		TSequence gating_sequence_cache_;
-		TWaitStrategy wait_strategy_;
-		std::vector<TSequence*> gating_sequences_;
-		int available_buffer_[BufferSize];
+		cache_line_storage<TWaitStrategy, CACHE_LINE_PADDING_SIZE> wait_strategy_;
+		TGatingSequences gating_sequences_;
+		alignas(CACHE_LINE_PADDING_SIZE) std::atomic<int> available_buffer_[BufferSize];
 	};
 }
 
@@ -90,7 +90,7 @@ namespace disruptor4cpp
 			// Implemenent with the same logic in batch event processor without notification.
 			// Different from the java version.
 			sequence_barrier_.clear_alert();
-			int64_t next_sequence = sequence_.get() + 1;
+			int64_t next_sequence = sequence_.get_relaxed() + 1;
 			try
 			{
 				while (true)
@@ -0,0 +1,118 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_OFFSET_SEQUENCE_LIST_H_
+#define DISRUPTOR4CPP_OFFSET_SEQUENCE_LIST_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "sequence.h"
+#include "utils/offset_ptr.h"
+
+namespace disruptor4cpp
+{
+	// Fixed capacity list of sequences held through offset pointers. It can replace the
+	// std::vector of gating sequences in a sequencer placed in memory shared between processes,
+	// as long as the sequences themselves live in the same shared memory.
+	template <typename TSequence = sequence, std::size_t Capacity = 16>
+	class offset_sequence_list
+	{
+	public:
+		typedef offset_ptr<TSequence> value_type;
+		typedef offset_ptr<TSequence>* iterator;
+		typedef const offset_ptr<TSequence>* const_iterator;
+
+		static constexpr std::size_t CAPACITY = Capacity;
+
+		offset_sequence_list()
+			: size_(0)
+		{
+		}
+
+		~offset_sequence_list() = default;
+
+		void push_back(TSequence* seq)
+		{
+			if (size_ == Capacity)
+				throw std::length_error("offset_sequence_list is full");
+			sequences_[size_++] = seq;
+		}
+
+		iterator erase(iterator pos)
+		{
+			for (iterator iter = pos; iter + 1 != end(); ++iter)
+				*iter = *(iter + 1);
+			sequences_[--size_] = nullptr;
+			return pos;
+		}
+
+		std::size_t size() const
+		{
+			return size_;
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+
+		iterator begin()
+		{
+			return sequences_;
+		}
+
+		iterator end()
+		{
+			return sequences_ + size_;
+		}
+
+		const_iterator begin() const
+		{
+			return sequences_;
+		}
+
+		const_iterator end() const
+		{
+			return sequences_ + size_;
+		}
+
+	private:
+		offset_sequence_list(const offset_sequence_list&) = delete;
+		offset_sequence_list& operator=(const offset_sequence_list&) = delete;
+		offset_sequence_list(offset_sequence_list&&) = delete;
+		offset_sequence_list& operator=(offset_sequence_list&&) = delete;
+
+		offset_ptr<TSequence> sequences_[Capacity];
+		std::size_t size_;
+	};
+}
+
+#endif
@@ -0,0 +1,295 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_PIPELINE_H_
+#define DISRUPTOR4CPP_PIPELINE_H_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "batch_event_processor.h"
+
+namespace disruptor4cpp
+{
+	// A pipeline stage handled by THandler, consuming after the stages at the given indices, or
+	// directly after the producers if there are none.
+	template <typename THandler, std::size_t... Dependencies>
+	struct stage
+	{
+		typedef THandler handler_type;
+		static constexpr std::size_t DEPENDENCY_COUNT = sizeof...(Dependencies);
+	};
+
+	template <std::size_t Value, std::size_t... Values>
+	struct pipeline_contains : std::false_type
+	{
+	};
+
+	template <std::size_t Value, std::size_t First, std::size_t... Rest>
+	struct pipeline_contains<Value, First, Rest...>
+		: std::integral_constant<bool, Value == First || pipeline_contains<Value, Rest...>::value>
+	{
+	};
+
+	template <std::size_t Bound, std::size_t... Values>
+	struct pipeline_all_less : std::true_type
+	{
+	};
+
+	template <std::size_t Bound, std::size_t First, std::size_t... Rest>
+	struct pipeline_all_less<Bound, First, Rest...>
+		: std::integral_constant<bool, First < Bound && pipeline_all_less<Bound, Rest...>::value>
+	{
+	};
+
+	// Whether any of TStages consumes after stage Index.
+	template <std::size_t Index, typename... TStages>
+	struct pipeline_is_dependency : std::false_type
+	{
+	};
+
+	template <std::size_t Index, typename THandler, std::size_t... Dependencies, typename... TRest>
+	struct pipeline_is_dependency<Index, stage<THandler, Dependencies...>, TRest...>
+		: std::integral_constant<bool, pipeline_contains<Index, Dependencies...>::value
+			|| pipeline_is_dependency<Index, TRest...>::value>
+	{
+	};
+
+	template <std::size_t Index, typename... TStages>
+	struct pipeline_is_dependency<Index, std::tuple<TStages...>> : pipeline_is_dependency<Index, TStages...>
+	{
+	};
+
+	template <typename TRingBuffer, typename TStage>
+	struct pipeline_barrier;
+
+	template <typename TRingBuffer, typename THandler>
+	struct pipeline_barrier<TRingBuffer, stage<THandler>>
+	{
+		typedef typename TRingBuffer::sequence_barrier_type type;
+	};
+
+	template <typename TRingBuffer, typename THandler, std::size_t First, std::size_t... Rest>
+	struct pipeline_barrier<TRingBuffer, stage<THandler, First, Rest...>>
+	{
+		typedef typename TRingBuffer::template static_sequence_barrier_type<1 + sizeof...(Rest)> type;
+	};
+
+	// Holds the processors of the first Count stages, each node deriving from the previous one,
+	// so that the stages a processor depends on are constructed before it.
+	template <typename TRingBuffer, typename TStageTuple, std::size_t Count>
+	class pipeline_node : public pipeline_node<TRingBuffer, TStageTuple, Count - 1>
+	{
+	public:
+		typedef typename std::tuple_element<Count - 1, TStageTuple>::type stage_type;
+		typedef typename stage_type::handler_type handler_type;
+		typedef batch_event_processor<TRingBuffer,
+			typename pipeline_barrier<TRingBuffer, stage_type>::type, handler_type> processor_type;
+
+		template <typename THandlers>
+		pipeline_node(TRingBuffer& ring_buffer, const THandlers& handlers)
+			: base_type(ring_buffer, handlers),
+			  processor_(ring_buffer, create_barrier(ring_buffer, stage_type()), std::get<Count - 1>(handlers))
+		{
+		}
+
+		template <std::size_t Index>
+		typename pipeline_node<TRingBuffer, TStageTuple, Index + 1>::processor_type& get_processor()
+		{
+			return static_cast<pipeline_node<TRingBuffer, TStageTuple, Index + 1>&>(*this).processor_;
+		}
+
+		void start_stages()
+		{
+			base_type::start_stages();
+			try
+			{
+				processor_.start();
+			}
+			catch (...)
+			{
+				// Leave no earlier stage running, and gating the ring, behind a failed start.
+				base_type::shutdown_stages();
+				throw;
+			}
+		}
+
+		void shutdown_stages()
+		{
+			base_type::shutdown_stages();
+			processor_.shutdown();
+		}
+
+		bool stages_running() const
+		{
+			return base_type::stages_running() && processor_.is_running();
+		}
+
+		int process_stages(int max_events)
+		{
+			int processed = base_type::process_stages(max_events);
+			return processed + processor_.process_available(max_events);
+		}
+
+		void collect_terminal_sequences(std::vector<typename TRingBuffer::sequence_type*>& sequences)
+		{
+			base_type::collect_terminal_sequences(sequences);
+			if (!pipeline_is_dependency<Count - 1, TStageTuple>::value)
+				sequences.push_back(&processor_.get_sequence());
+		}
+
+		processor_type processor_;
+
+	private:
+		typedef pipeline_node<TRingBuffer, TStageTuple, Count - 1> base_type;
+
+		template <typename THandler>
+		std::unique_ptr<typename TRingBuffer::sequence_barrier_type> create_barrier(TRingBuffer& ring_buffer,
+			stage<THandler>)
+		{
+			return ring_buffer.new_barrier();
+		}
+
+		template <typename THandler, std::size_t First, std::size_t... Rest>
+		std::unique_ptr<typename TRingBuffer::template static_sequence_barrier_type<1 + sizeof...(Rest)>> create_barrier(
+			TRingBuffer& ring_buffer, stage<THandler, First, Rest...>)
+		{
+			static_assert(pipeline_all_less<Count - 1, First, Rest...>::value,
+				"A stage can only depend on the stages before it");
+			return ring_buffer.new_barrier(std::array<typename TRingBuffer::sequence_type*, 1 + sizeof...(Rest)> { {
+				&get_processor<First>().get_sequence(), &get_processor<Rest>().get_sequence()... } });
+		}
+	};
+
+	template <typename TRingBuffer, typename TStageTuple>
+	class pipeline_node<TRingBuffer, TStageTuple, 0>
+	{
+	public:
+		template <typename THandlers>
+		pipeline_node(TRingBuffer& ring_buffer, const THandlers& handlers)
+		{
+		}
+
+		void start_stages()
+		{
+		}
+
+		void shutdown_stages()
+		{
+		}
+
+		bool stages_running() const
+		{
+			return true;
+		}
+
+		int process_stages(int max_events)
+		{
+			return 0;
+		}
+
+		void collect_terminal_sequences(std::vector<typename TRingBuffer::sequence_type*>& sequences)
+		{
+		}
+	};
+
+	// Consumer graph of one ring buffer described at compile time, e.g.
+	//   pipeline<ring_type, stage<journaler>, stage<replicator>, stage<business_logic, 0, 1>>
+	// Stage i gets a batch_event_processor whose barrier waits on exactly the sequences of its
+	// dependencies and which calls its handler through the handler's own type, and the ring is
+	// gated on the stages nothing depends on. Stages can be driven
+	// together from one thread with process_available (e.g. by an agent_runner), or each
+	// processor from get_processor<i>() can be run on its own thread.
+	template <typename TRingBuffer, typename... TStages>
+	class pipeline : private pipeline_node<TRingBuffer, std::tuple<TStages...>, sizeof...(TStages)>
+	{
+	public:
+		static_assert(sizeof...(TStages) > 0, "Pipeline must have at least one stage");
+
+		static constexpr std::size_t STAGE_COUNT = sizeof...(TStages);
+
+		template <std::size_t Index>
+		using processor_type = typename pipeline_node<TRingBuffer, std::tuple<TStages...>, Index + 1>::processor_type;
+
+		pipeline(TRingBuffer& ring_buffer, typename TStages::handler_type&... handlers)
+			: node_type(ring_buffer, std::tuple<typename TStages::handler_type&...>(handlers...))
+		{
+			std::vector<typename TRingBuffer::sequence_type*> terminal_sequences;
+			node_type::collect_terminal_sequences(terminal_sequences);
+			ring_buffer.add_gating_sequences(terminal_sequences);
+		}
+
+		~pipeline() = default;
+
+		template <std::size_t Index>
+		processor_type<Index>& get_processor()
+		{
+			static_assert(Index < STAGE_COUNT, "Stage index out of range");
+			return node_type::template get_processor<Index>();
+		}
+
+		void start()
+		{
+			node_type::start_stages();
+		}
+
+		void shutdown()
+		{
+			node_type::shutdown_stages();
+		}
+
+		// Whether every stage is running; false once any of them has halted.
+		bool is_running() const
+		{
+			return node_type::stages_running();
+		}
+
+		// Runs process_available on every stage in order, which lets an event pass through all
+		// the stages in one call; returns the total number of events processed.
+		int process_available(int max_events)
+		{
+			return node_type::process_stages(max_events);
+		}
+
+	private:
+		typedef pipeline_node<TRingBuffer, std::tuple<TStages...>, sizeof...(TStages)> node_type;
+
+		pipeline(const pipeline&) = delete;
+		pipeline& operator=(const pipeline&) = delete;
+		pipeline(pipeline&&) = delete;
+		pipeline& operator=(pipeline&&) = delete;
+	};
+}
+
+#endif
@@ -0,0 +1,393 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_PRIORITY_EVENT_PROCESSOR_H_
+#define DISRUPTOR4CPP_PRIORITY_EVENT_PROCESSOR_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "event_handler.h"
+#include "exception_handlers/default_exception_handler.h"
+#include "exception_handlers/exception_action.h"
+#include "exceptions/alert_exception.h"
+#include "exceptions/timeout_exception.h"
+#include "sequence.h"
+#include "static_sequence_group.h"
+
+namespace disruptor4cpp
+{
+	class priority_lane_base
+	{
+	public:
+		virtual ~priority_lane_base() { }
+		virtual int get_priority() const = 0;
+		virtual bool has_available() const = 0;
+		// Returns false if the lane's exception handler asked to halt the processor.
+		virtual bool process_available() = 0;
+		// Returns false if the lane's exception handler asked to halt the processor.
+		virtual bool notify_timeout() = 0;
+		virtual void notify_start() = 0;
+		virtual void notify_shutdown() = 0;
+	};
+
+	// One ring buffer consumed by a priority_event_processor: its barrier, its handler and the
+	// sequence to add to the ring's gating sequences. Lanes with a higher priority are drained
+	// first, at most max_batch_size events per round, so that a backlog on one lane holds up the
+	// others for one batch only. Handler exceptions go through TExceptionHandler as in
+	// batch_event_processor; exception_action::halt halts the whole processor and leaves the
+	// failing event unconsumed.
+	template <typename TRingBuffer, typename TExceptionHandler = default_exception_handler>
+	class priority_lane : public priority_lane_base
+	{
+	public:
+		static constexpr int DEFAULT_MAX_BATCH_SIZE = 64;
+
+		priority_lane(TRingBuffer& ring_buffer,
+			typename TRingBuffer::sequence_barrier_type& sequence_barrier,
+			event_handler<typename TRingBuffer::event_type>& evt_handler, int priority,
+			int max_batch_size = DEFAULT_MAX_BATCH_SIZE)
+			: sequence_(),
+			  ring_buffer_(ring_buffer),
+			  sequence_barrier_(sequence_barrier),
+			  event_handler_(evt_handler),
+			  priority_(priority),
+			  max_batch_size_(max_batch_size)
+		{
+			if (max_batch_size < 1)
+				throw std::invalid_argument("max_batch_size must be > 0");
+		}
+
+		priority_lane(TRingBuffer& ring_buffer,
+			std::unique_ptr<typename TRingBuffer::sequence_barrier_type> sequence_barrier_ptr,
+			event_handler<typename TRingBuffer::event_type>& evt_handler, int priority,
+			int max_batch_size = DEFAULT_MAX_BATCH_SIZE)
+			: sequence_(),
+			  ring_buffer_(ring_buffer),
+			  sequence_barrier_(*sequence_barrier_ptr),
+			  event_handler_(evt_handler),
+			  sequence_barrier_ptr_(std::move(sequence_barrier_ptr)),
+			  priority_(priority),
+			  max_batch_size_(max_batch_size)
+		{
+			if (max_batch_size < 1)
+				throw std::invalid_argument("max_batch_size must be > 0");
+		}
+
+		virtual ~priority_lane() = default;
+
+		typename TRingBuffer::sequence_type& get_sequence()
+		{
+			return sequence_;
+		}
+
+		virtual int get_priority() const
+		{
+			return priority_;
+		}
+
+		virtual bool has_available() const
+		{
+			const int64_t next_sequence = sequence_.get_relaxed() + 1;
+			return sequence_barrier_.get_available_sequence(next_sequence) >= next_sequence;
+		}
+
+		virtual bool process_available()
+		{
+			const int64_t next_sequence = sequence_.get_relaxed() + 1;
+			const int64_t available_sequence = sequence_barrier_.get_available_sequence(next_sequence);
+			if (available_sequence < next_sequence)
+				return true;
+
+			const int64_t hi = std::min(available_sequence, next_sequence + max_batch_size_ - 1);
+			for (int64_t seq = next_sequence; seq <= hi; seq++)
+			{
+				auto& event = ring_buffer_[seq];
+				try
+				{
+					event_handler_.on_event(event, seq, seq == hi);
+				}
+				catch (std::exception& ex)
+				{
+					sequence_.set(seq - 1);
+					if (exception_handler_.on_event_exception(ex, seq, &event, event_handler_)
+						== exception_action::halt)
+						return false;
+				}
+			}
+			sequence_.set(hi);
+			return true;
+		}
+
+		virtual bool notify_timeout()
+		{
+			const int64_t sequence = sequence_.get_relaxed();
+			try
+			{
+				event_handler_.on_timeout(sequence);
+			}
+			catch (std::exception& ex)
+			{
+				if (exception_handler_.on_event_exception(ex, sequence,
+					static_cast<typename TRingBuffer::event_type*>(nullptr), event_handler_) == exception_action::halt)
+					return false;
+			}
+			return true;
+		}
+
+		virtual void notify_start()
+		{
+			try
+			{
+				event_handler_.on_start();
+			}
+			catch (std::exception& ex)
+			{
+				exception_handler_.on_start_exception(ex, event_handler_);
+			}
+		}
+
+		virtual void notify_shutdown()
+		{
+			try
+			{
+				event_handler_.on_shutdown();
+			}
+			catch (std::exception& ex)
+			{
+				exception_handler_.on_shutdown_exception(ex, event_handler_);
+			}
+		}
+
+	private:
+		priority_lane(const priority_lane&) = delete;
+		priority_lane& operator=(const priority_lane&) = delete;
+		priority_lane(priority_lane&&) = delete;
+		priority_lane& operator=(priority_lane&&) = delete;
+
+		typename TRingBuffer::sequence_type sequence_;
+		TRingBuffer& ring_buffer_;
+		typename TRingBuffer::sequence_barrier_type& sequence_barrier_;
+		event_handler<typename TRingBuffer::event_type>& event_handler_;
+		std::unique_ptr<typename TRingBuffer::sequence_barrier_type> sequence_barrier_ptr_;
+		int priority_;
+		int max_batch_size_;
+		TExceptionHandler exception_handler_;
+	};
+
+	// Consumes several ring buffers on one thread. Each round processes a batch of the highest
+	// priority lane that has events, except that a lane passed over StarvationLimit
+	// rounds in a row while it had events is served first. When no lane has events, the
+	// processor blocks in TWaitStrategy, which the rings' producers must signal: give every ring
+	// the same shared_wait_strategy<..., TTag> type and use it here as well.
+	template <typename TWaitStrategy, std::size_t StarvationLimit = 16>
+	class priority_event_processor
+	{
+	public:
+		static_assert(StarvationLimit > 0, "StarvationLimit must be > 0");
+
+		explicit priority_event_processor(const std::vector<priority_lane_base*>& lanes)
+			: lanes_(lanes),
+			  skipped_(lanes.size(), 0),
+			  pending_sequence_(lanes_),
+			  running_(false),
+			  alerted_(false)
+		{
+			if (lanes_.empty())
+				throw std::invalid_argument("lanes must not be empty");
+			std::stable_sort(lanes_.begin(), lanes_.end(),
+				[](const priority_lane_base* lhs, const priority_lane_base* rhs)
+				{
+					return lhs->get_priority() > rhs->get_priority();
+				});
+		}
+
+		~priority_event_processor() = default;
+
+		void halt()
+		{
+			running_.store(false, std::memory_order_release);
+			alerted_.store(true, std::memory_order_release);
+			wait_strategy_.signal_all_when_blocking();
+		}
+
+		bool is_running() const
+		{
+			return running_.load(std::memory_order_acquire);
+		}
+
+		void run()
+		{
+			bool expected_running_state = false;
+			if (!running_.compare_exchange_strong(expected_running_state, true))
+				throw std::runtime_error("Thread is already running");
+
+			alerted_.store(false, std::memory_order_release);
+			for (auto lane : lanes_)
+				lane->notify_start();
+
+			const static_sequence_group<pending_sequence, 1> pending_group =
+				static_sequence_group<pending_sequence, 1>::create(
+					std::array<const pending_sequence*, 1> { { &pending_sequence_ } });
+			try
+			{
+				while (true)
+				{
+					try
+					{
+						check_alert();
+						if (!process_once())
+							wait_strategy_.wait_for(0, pending_sequence_, pending_group, *this);
+					}
+					catch (timeout_exception& timeout_ex)
+					{
+						notify_timeout();
+					}
+					catch (alert_exception& alert_ex)
+					{
+						if (!running_.load(std::memory_order_acquire))
+							break;
+					}
+				}
+			}
+			catch (...)
+			{
+				notify_shutdown();
+				throw;
+			}
+			notify_shutdown();
+		}
+
+		// Runs one scheduling round without blocking; returns false if no lane had events.
+		bool process_once()
+		{
+			std::size_t chosen = lanes_.size();
+			std::size_t first_available = lanes_.size();
+			for (std::size_t i = 0; i < lanes_.size(); i++)
+			{
+				if (!lanes_[i]->has_available())
+				{
+					skipped_[i] = 0;
+					continue;
+				}
+				if (first_available == lanes_.size())
+					first_available = i;
+				if (chosen == lanes_.size() && skipped_[i] >= StarvationLimit)
+					chosen = i;
+				++skipped_[i];
+			}
+			if (first_available == lanes_.size())
+				return false;
+			if (chosen == lanes_.size())
+				chosen = first_available;
+
+			skipped_[chosen] = 0;
+			if (!lanes_[chosen]->process_available())
+				halt();
+			return true;
+		}
+
+		bool is_alerted() const
+		{
+			return alerted_.load(std::memory_order_acquire);
+		}
+
+		void check_alert() const
+		{
+			if (is_alerted())
+				throw alert_exception();
+		}
+
+	private:
+		priority_event_processor(const priority_event_processor&) = delete;
+		priority_event_processor& operator=(const priority_event_processor&) = delete;
+		priority_event_processor(priority_event_processor&&) = delete;
+		priority_event_processor& operator=(priority_event_processor&&) = delete;
+
+		// Sequence-like view for the wait strategy: 0 once any lane has events, -1 otherwise.
+		class pending_sequence
+		{
+		public:
+			explicit pending_sequence(const std::vector<priority_lane_base*>& lanes)
+				: lanes_(lanes)
+			{
+			}
+
+			int64_t get() const
+			{
+				for (auto lane : lanes_)
+				{
+					if (lane->has_available())
+						return 0;
+				}
+				return -1;
+			}
+
+		private:
+			const std::vector<priority_lane_base*>& lanes_;
+		};
+
+		// A timeout of the wait strategy means that no lane had events for the whole period.
+		void notify_timeout()
+		{
+			bool halted = false;
+			for (auto lane : lanes_)
+			{
+				if (!lane->notify_timeout())
+					halted = true;
+			}
+			if (halted)
+				halt();
+		}
+
+		void notify_shutdown()
+		{
+			for (auto lane : lanes_)
+				lane->notify_shutdown();
+			running_.store(false, std::memory_order_release);
+		}
+
+		std::vector<priority_lane_base*> lanes_;
+		std::vector<std::size_t> skipped_;
+		pending_sequence pending_sequence_;
+		TWaitStrategy wait_strategy_;
+		std::atomic<bool> running_;
+		std::atomic<bool> alerted_;
+	};
+}
+
+#endif
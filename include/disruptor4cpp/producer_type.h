@@ -36,7 +36,9 @@ namespace disruptor4cpp
 	enum class producer_type : int
 	{
 		single,
-		multi
+		multi,
+		// multi, claiming with claim_strategy::fetch_add
+		multi_fetch_add
 	};
 }
 
@@ -0,0 +1,344 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_RECORD_RING_BUFFER_H_
+#define DISRUPTOR4CPP_RECORD_RING_BUFFER_H_
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "exceptions/alert_exception.h"
+#include "exceptions/insufficient_capacity_exception.h"
+#include "fixed_sequence_group.h"
+#include "producer_type.h"
+#include "sequence.h"
+#include "utils/cache_line_storage.h"
+
+namespace disruptor4cpp
+{
+	// Ring buffer of variable length records for many-to-one (producer_type::multi) or one-to-one
+	// (producer_type::single) messaging, with the record layout of Agrona's ring buffers.
+	//
+	// Each record is an 8 byte header (length including the header, then message type id) followed
+	// by the payload, aligned to 8 bytes. The length is negative while the record is claimed and is
+	// made positive on commit. A record never wraps: the space left at the end of the buffer is
+	// filled with a padding record instead. Producers can encode in place between claim and commit.
+	template <std::size_t Capacity, typename TWaitStrategy,
+		producer_type ProducerType = producer_type::multi, typename TSequence = sequence>
+	class record_ring_buffer
+	{
+	public:
+		static_assert((Capacity & (~Capacity + 1)) == Capacity, "Capacity must be a power of 2");
+		static_assert(Capacity >= 64, "Capacity must be at least 64 bytes");
+		static_assert(ProducerType == producer_type::single || ProducerType == producer_type::multi,
+			"Unsupported producer type");
+
+		typedef TWaitStrategy wait_strategy_type;
+		typedef TSequence sequence_type;
+
+		static constexpr std::size_t CAPACITY = Capacity;
+		static constexpr std::size_t HEADER_LENGTH = 2 * sizeof(int32_t);
+		static constexpr std::size_t ALIGNMENT = HEADER_LENGTH;
+		static constexpr std::size_t MAX_MESSAGE_LENGTH = Capacity / 8;
+		static constexpr int32_t PADDING_MSG_TYPE_ID = -1;
+
+		record_ring_buffer()
+			: tail_(0),
+			  head_cache_(0),
+			  head_(0),
+			  dependent_sequence_(fixed_sequence_group<TSequence>::create(tail_)),
+			  wait_strategy_(),
+			  alerted_(false)
+		{
+			std::memset(buffer_, 0, sizeof(buffer_));
+		}
+
+		~record_ring_buffer() = default;
+
+		TWaitStrategy& get_wait_strategy()
+		{
+			return wait_strategy_.data;
+		}
+
+		// Claims space for a message of the given length and returns the index of its payload,
+		// yielding while the buffer is full.
+		int64_t claim(int32_t msg_type_id, std::size_t length)
+		{
+			check_message(msg_type_id, length);
+			int64_t record_index;
+			while ((record_index = claim_capacity(aligned_length(length + HEADER_LENGTH))) < 0)
+			{
+				std::this_thread::yield();
+			}
+			return begin_record(record_index, msg_type_id, length);
+		}
+
+		// As claim, but throws insufficient_capacity_exception if the buffer is full.
+		int64_t try_claim(int32_t msg_type_id, std::size_t length)
+		{
+			check_message(msg_type_id, length);
+			int64_t record_index = claim_capacity(aligned_length(length + HEADER_LENGTH));
+			if (record_index < 0)
+				throw insufficient_capacity_exception();
+			return begin_record(record_index, msg_type_id, length);
+		}
+
+		uint8_t* get_data(int64_t index)
+		{
+			return buffer_ + index;
+		}
+
+		// Makes a claimed message available to the consumer.
+		void commit(int64_t index)
+		{
+			std::atomic<int32_t>& length = length_at(index - HEADER_LENGTH);
+			length.store(-length.load(std::memory_order_relaxed), std::memory_order_release);
+			wait_strategy_.data.signal_all_when_blocking();
+		}
+
+		// Gives up a claimed message; the consumer skips it.
+		void abort(int64_t index)
+		{
+			type_at(index - HEADER_LENGTH) = PADDING_MSG_TYPE_ID;
+			commit(index);
+		}
+
+		void write(int32_t msg_type_id, const void* src, std::size_t length)
+		{
+			int64_t index = claim(msg_type_id, length);
+			std::memcpy(buffer_ + index, src, length);
+			commit(index);
+		}
+
+		// Reads up to limit messages, stopping at the end of the buffer or at a message that is
+		// not committed yet, and returns the number read. The handler is called with
+		// (int32_t msg_type_id, const uint8_t* data, std::size_t length). Must only be called by the
+		// single consumer.
+		template <typename THandler>
+		int read(THandler&& handler, int limit = INT_MAX)
+		{
+			const int64_t head = head_.get_relaxed();
+			const std::size_t head_index = head & (Capacity - 1);
+			const std::size_t contiguous_length = Capacity - head_index;
+			std::size_t bytes_read = 0;
+			int messages_read = 0;
+			try
+			{
+				while (bytes_read < contiguous_length && messages_read < limit)
+				{
+					const std::size_t record_index = head_index + bytes_read;
+					const int32_t length = length_at(record_index).load(std::memory_order_acquire);
+					if (length <= 0)
+						break;
+
+					bytes_read += aligned_length(length);
+					const int32_t msg_type_id = type_at(record_index);
+					if (msg_type_id == PADDING_MSG_TYPE_ID)
+						continue;
+
+					++messages_read;
+					handler(msg_type_id, static_cast<const uint8_t*>(buffer_ + record_index + HEADER_LENGTH),
+						static_cast<std::size_t>(length) - HEADER_LENGTH);
+				}
+			}
+			catch (...)
+			{
+				release(head, head_index, bytes_read);
+				throw;
+			}
+			release(head, head_index, bytes_read);
+			return messages_read;
+		}
+
+		// Blocks in the wait strategy until a record is claimed past the consumer position.
+		// A claimed record may not be committed yet, in which case read returns 0.
+		void wait_for_records()
+		{
+			check_alert();
+			wait_strategy_.data.wait_for(head_.get_relaxed() + 1, tail_, dependent_sequence_, *this);
+		}
+
+		std::size_t size() const
+		{
+			int64_t head_before;
+			int64_t tail;
+			int64_t head_after = head_.get();
+			do
+			{
+				head_before = head_after;
+				tail = tail_.get();
+				head_after = head_.get();
+			}
+			while (head_after != head_before);
+			return static_cast<std::size_t>(tail - head_after);
+		}
+
+		bool is_alerted() const
+		{
+			return alerted_.load(std::memory_order_acquire);
+		}
+
+		void alert()
+		{
+			alerted_.store(true, std::memory_order_release);
+			wait_strategy_.data.signal_all_when_blocking();
+		}
+
+		void clear_alert()
+		{
+			alerted_.store(false, std::memory_order_release);
+		}
+
+		void check_alert() const
+		{
+			if (is_alerted())
+				throw alert_exception();
+		}
+
+	private:
+		record_ring_buffer(const record_ring_buffer&) = delete;
+		record_ring_buffer& operator=(const record_ring_buffer&) = delete;
+		record_ring_buffer(record_ring_buffer&&) = delete;
+		record_ring_buffer& operator=(record_ring_buffer&&) = delete;
+
+		static std::size_t aligned_length(std::size_t length)
+		{
+			return (length + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		}
+
+		static void check_message(int32_t msg_type_id, std::size_t length)
+		{
+			if (msg_type_id < 1)
+				throw std::invalid_argument("msg_type_id must be > 0");
+			if (length > MAX_MESSAGE_LENGTH)
+				throw std::invalid_argument("length must be <= MAX_MESSAGE_LENGTH");
+		}
+
+		std::atomic<int32_t>& length_at(std::size_t record_index)
+		{
+			return *reinterpret_cast<std::atomic<int32_t>*>(buffer_ + record_index);
+		}
+
+		int32_t& type_at(std::size_t record_index)
+		{
+			return *reinterpret_cast<int32_t*>(buffer_ + record_index + sizeof(int32_t));
+		}
+
+		int64_t begin_record(int64_t record_index, int32_t msg_type_id, std::size_t length)
+		{
+			type_at(record_index) = msg_type_id;
+			length_at(record_index).store(-static_cast<int32_t>(length + HEADER_LENGTH), std::memory_order_release);
+			return record_index + HEADER_LENGTH;
+		}
+
+		// Returns the index of the claimed record or -1 if there is not enough space.
+		int64_t claim_capacity(std::size_t required)
+		{
+			const std::size_t mask = Capacity - 1;
+			// Other producers write the head cache, so with several producers it is read with
+			// acquire to see the consumer's zeroing of the space it frees.
+			int64_t head = ProducerType == producer_type::single ? head_cache_.get_relaxed() : head_cache_.get();
+			int64_t tail;
+			std::size_t tail_index;
+			std::size_t padding;
+			do
+			{
+				tail = ProducerType == producer_type::single ? tail_.get_relaxed() : tail_.get();
+				if (required > Capacity - (tail - head))
+				{
+					head = head_.get();
+					if (required > Capacity - (tail - head))
+						return -1;
+					head_cache_.set(head);
+				}
+
+				padding = 0;
+				tail_index = tail & mask;
+				const std::size_t to_buffer_end = Capacity - tail_index;
+				if (required > to_buffer_end)
+				{
+					std::size_t head_index = head & mask;
+					if (required > head_index)
+					{
+						head = head_.get();
+						head_index = head & mask;
+						if (required > head_index)
+							return -1;
+						head_cache_.set(head);
+					}
+					padding = to_buffer_end;
+				}
+			}
+			while (!advance_tail(tail, tail + required + padding));
+
+			if (padding != 0)
+			{
+				type_at(tail_index) = PADDING_MSG_TYPE_ID;
+				length_at(tail_index).store(static_cast<int32_t>(padding), std::memory_order_release);
+				tail_index = 0;
+			}
+			return tail_index;
+		}
+
+		bool advance_tail(int64_t tail, int64_t new_tail)
+		{
+			if (ProducerType == producer_type::single)
+			{
+				tail_.set(new_tail);
+				return true;
+			}
+			return tail_.compare_and_set(tail, new_tail);
+		}
+
+		// Zeroes the consumed records, so that claims find a zero length, then frees them.
+		void release(int64_t head, std::size_t head_index, std::size_t bytes_read)
+		{
+			if (bytes_read == 0)
+				return;
+			std::memset(buffer_ + head_index, 0, bytes_read);
+			head_.set(head + bytes_read);
+		}
+
+		TSequence tail_;
+		TSequence head_cache_;
+		TSequence head_;
+		fixed_sequence_group<TSequence> dependent_sequence_;
+		cache_line_storage<TWaitStrategy, CACHE_LINE_PADDING_SIZE> wait_strategy_;
+		std::atomic<bool> alerted_;
+		alignas(CACHE_LINE_PADDING_SIZE) uint8_t buffer_[Capacity];
+	};
+}
+
+#endif
@@ -33,18 +33,23 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cstddef>
 #include <cstdint>
+#include <new>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "producer_type.h"
 #include "sequencer_traits.h"
+#include "strided_span.h"
 #include "utils/cache_line_storage.h"
 
 namespace disruptor4cpp
 {
 	template <typename TEvent, std::size_t BufferSize,
-		typename TWaitStrategy, producer_type ProducerType, typename TSequence = sequence>
+		typename TWaitStrategy, producer_type ProducerType, typename TSequence = sequence,
+		typename TGatingSequences = std::vector<TSequence*>>
 	class ring_buffer :
-		public sequencer_traits<BufferSize, TWaitStrategy, TSequence, ProducerType>::sequencer_type
+		public sequencer_traits<BufferSize, TWaitStrategy, TSequence, ProducerType, TGatingSequences>::sequencer_type
 	{
 	public:
 		static_assert(std::is_default_constructible<TEvent>::value, "Event type must be default constructible");
@@ -53,7 +58,9 @@ namespace disruptor4cpp
 		typedef TEvent event_type;
 		typedef TWaitStrategy wait_strategy_type;
 		typedef TSequence sequence_type;
-		typedef typename sequencer_traits<BufferSize, TWaitStrategy, TSequence, ProducerType>::sequence_barrier_type sequence_barrier_type;
+		typedef TGatingSequences gating_sequences_type;
+		typedef typename sequencer_traits<BufferSize, TWaitStrategy, TSequence,
+			ProducerType, TGatingSequences>::sequence_barrier_type sequence_barrier_type;
 
 		static constexpr std::size_t BUFFER_SIZE = BufferSize;
 		static constexpr producer_type PRODUCER_TYPE = ProducerType;
@@ -68,6 +75,23 @@ namespace disruptor4cpp
 			}
 		}
 
+		// Constructs the event in slot i from factory(i), for events that must be built with
+		// per-slot state such as an arena_region. The event is moved into place rather than
+		// assigned, so its allocator comes along with it.
+		template <typename TEventFactory, typename = typename std::enable_if<
+			std::is_convertible<decltype(std::declval<TEventFactory&>()(std::size_t())), TEvent>::value>::type>
+		explicit ring_buffer(TEventFactory factory)
+		{
+			static_assert(std::is_nothrow_move_constructible<TEvent>::value,
+				"Event type must be nothrow move constructible");
+			for (std::size_t i = 0; i < BufferSize; i++)
+			{
+				TEvent event(factory(i));
+				events_[i].data.~TEvent();
+				new (&events_[i].data) TEvent(std::move(event));
+			}
+		}
+
 		~ring_buffer() = default;
 
 		TEvent& operator[](int64_t seq)
@@ -80,6 +104,19 @@ namespace disruptor4cpp
 			return events_[seq & (BufferSize - 1)].data;
 		}
 
+		// The events [lo, hi] as at most two segments, split where the range wraps. Each segment
+		// steps over the slot padding, so it is strided rather than contiguous.
+		// The range must not span more than the buffer size.
+		std::pair<strided_span<TEvent>, strided_span<TEvent>> get_segments(int64_t lo, int64_t hi)
+		{
+			const std::size_t index = lo & (BufferSize - 1);
+			const std::size_t count = hi - lo + 1;
+			const std::size_t first_count = count < BufferSize - index ? count : BufferSize - index;
+			return std::make_pair(
+				strided_span<TEvent>(&events_[index].data, first_count, sizeof(events_[0])),
+				strided_span<TEvent>(&events_[0].data, count - first_count, sizeof(events_[0])));
+		}
+
 	private:
 		ring_buffer(const ring_buffer&) = delete;
 		ring_buffer& operator=(const ring_buffer&) = delete;
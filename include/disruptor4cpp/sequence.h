@@ -32,42 +32,60 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DISRUPTOR4CPP_SEQUENCE_H_
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 #include "utils/cache_line_storage.h"
 
 namespace disruptor4cpp
 {
-	class sequence
+	template <std::size_t PaddingSize = CACHE_LINE_PADDING_SIZE>
+	class basic_sequence
 	{
 	public:
+		static_assert(PaddingSize >= sizeof(std::atomic<int64_t>), "Padding must hold the sequence");
+
 		static constexpr int64_t INITIAL_VALUE = -1;
 
-		sequence()
+		basic_sequence()
 			: sequence_(INITIAL_VALUE)
 		{
 		}
 
-		explicit sequence(int64_t initial_value)
+		explicit basic_sequence(int64_t initial_value)
 			: sequence_(initial_value)
 		{
 		}
 
-		~sequence() = default;
+		~basic_sequence() = default;
 
 		int64_t get() const
 		{
 			return sequence_.load(std::memory_order_acquire);
 		}
 
+		// Only for a sequence written by the calling thread, e.g. a processor reading its own progress.
+		int64_t get_relaxed() const
+		{
+			return sequence_.load(std::memory_order_relaxed);
+		}
+
+		// Ordered (lazy) set: prior writes are visible to a thread that reads the value with get().
 		void set(int64_t value)
 		{
 			sequence_.store(value, std::memory_order_release);
 		}
 
-		bool compare_and_set(int64_t expected_value, int64_t new_value)
+		bool compare_and_set(int64_t expected_value, int64_t new_value,
+			std::memory_order order = std::memory_order_seq_cst)
 		{
-			return sequence_.compare_exchange_weak(expected_value, new_value);
+			return sequence_.compare_exchange_weak(expected_value, new_value, order);
+		}
+
+		bool compare_and_set(int64_t expected_value, int64_t new_value,
+			std::memory_order success_order, std::memory_order failure_order)
+		{
+			return sequence_.compare_exchange_weak(expected_value, new_value, success_order, failure_order);
 		}
 
 		int64_t increment_and_get()
@@ -75,20 +93,25 @@ namespace disruptor4cpp
 			return add_and_get(1);
 		}
 
-		int64_t add_and_get(int64_t increment)
+		int64_t add_and_get(int64_t increment, std::memory_order order = std::memory_order_release)
 		{
-			return sequence_.fetch_add(increment, std::memory_order_release) + increment;
+			return sequence_.fetch_add(increment, order) + increment;
 		}
 
 	private:
-		sequence(const sequence&) = delete;
-		sequence& operator=(const sequence&) = delete;
-		sequence(sequence&&) = delete;
-		sequence& operator=(sequence&&) = delete;
+		basic_sequence(const basic_sequence&) = delete;
+		basic_sequence& operator=(const basic_sequence&) = delete;
+		basic_sequence(basic_sequence&&) = delete;
+		basic_sequence& operator=(basic_sequence&&) = delete;
 
-		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> sequence_;
-		char padding[CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)];
+		alignas(PaddingSize) std::atomic<int64_t> sequence_;
+		char padding[PaddingSize - sizeof(std::atomic<int64_t>)];
 	};
+
+	template <std::size_t PaddingSize>
+	constexpr int64_t basic_sequence<PaddingSize>::INITIAL_VALUE;
+
+	typedef basic_sequence<> sequence;
 }
 
 #endif
@@ -37,25 +37,44 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "exceptions/alert_exception.h"
 #include "fixed_sequence_group.h"
 #include "sequence.h"
+#include "utils/cache_line_storage.h"
+#include "utils/tracepoint.h"
 #include "utils/util.h"
 
 namespace disruptor4cpp
 {
-	template <typename TSequencer>
+	// TSequenceGroup is the type of the dependency group the barrier waits on: by default a
+	// fixed_sequence_group sized at run time, or a static_sequence_group when the dependencies
+	// are known at compile time.
+	template <typename TSequencer,
+		typename TSequenceGroup = fixed_sequence_group<typename TSequencer::sequence_type>>
 	class sequence_barrier
 	{
 	public:
 		typedef TSequencer sequencer_type;
 		typedef typename TSequencer::wait_strategy_type wait_strategy_type;
 		typedef typename TSequencer::sequence_type sequence_type;
+		typedef TSequenceGroup sequence_group_type;
 
 		sequence_barrier(const TSequencer& sequencer,
 			wait_strategy_type& wait_strategy,
 			const sequence_type& cursor_sequence,
 			const std::vector<sequence_type*> dependent_sequences)
 			: dependent_sequence_(dependent_sequences.empty()
-				? fixed_sequence_group<sequence_type>::create(cursor_sequence)
-				: fixed_sequence_group<sequence_type>::create(dependent_sequences)),
+				? TSequenceGroup::create(cursor_sequence)
+				: TSequenceGroup::create(dependent_sequences)),
+			  sequencer_(sequencer),
+			  wait_strategy_(wait_strategy),
+			  cursor_sequence_(cursor_sequence),
+			  alerted_(false)
+		{
+		}
+
+		sequence_barrier(const TSequencer& sequencer,
+			wait_strategy_type& wait_strategy,
+			const sequence_type& cursor_sequence,
+			const TSequenceGroup& dependent_sequence)
+			: dependent_sequence_(dependent_sequence),
 			  sequencer_(sequencer),
 			  wait_strategy_(wait_strategy),
 			  cursor_sequence_(cursor_sequence),
@@ -68,8 +87,20 @@ namespace disruptor4cpp
 		int64_t wait_for(int64_t seq)
 		{
 			check_alert();
+			DISRUPTOR4CPP_TRACE2(wait_begin, this, seq);
 
 			int64_t available_sequence = wait_strategy_.wait_for(seq, cursor_sequence_, dependent_sequence_, *this);
+			if (available_sequence >= seq)
+				available_sequence = sequencer_.get_highest_published_sequence(seq, available_sequence);
+			DISRUPTOR4CPP_TRACE3(wait_end, this, seq, available_sequence);
+			return available_sequence;
+		}
+
+		// Returns the highest sequence available for processing without waiting; less than seq
+		// if seq itself is not available yet.
+		int64_t get_available_sequence(int64_t seq) const
+		{
+			int64_t available_sequence = dependent_sequence_.get();
 			if (available_sequence < seq)
 				return available_sequence;
 			return sequencer_.get_highest_published_sequence(seq, available_sequence);
@@ -108,11 +139,15 @@ namespace disruptor4cpp
 		sequence_barrier(sequence_barrier&&) = delete;
 		sequence_barrier& operator=(sequence_barrier&&) = delete;
 
-		fixed_sequence_group<sequence_type> dependent_sequence_;
+		// Barriers are allocated with new, which does not honour extended alignment before C++17,
+		// so the fields read on every wait are isolated by padding rather than alignment.
+		char padding0_[CACHE_LINE_PADDING_SIZE];
+		TSequenceGroup dependent_sequence_;
 		const TSequencer& sequencer_;
 		wait_strategy_type& wait_strategy_;
 		const sequence_type& cursor_sequence_;
 		std::atomic<bool> alerted_;
+		char padding1_[CACHE_LINE_PADDING_SIZE];
 	};
 }
 
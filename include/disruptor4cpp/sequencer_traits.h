@@ -32,7 +32,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DISRUPTOR4CPP_SEQUENCER_TRAITS_H_
 
 #include <cstddef>
+#include <vector>
 
+#include "claim_strategy.h"
 #include "multi_producer_sequencer.h"
 #include "producer_type.h"
 #include "sequence_barrier.h"
@@ -41,32 +43,48 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace disruptor4cpp
 {
 	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence
-		, producer_type ProducerType>
+		, producer_type ProducerType, typename TGatingSequences = std::vector<TSequence*>>
 	struct sequencer_traits;
 
-	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence>
-	struct sequencer_traits<BufferSize, TWaitStrategy, TSequence, producer_type::single>
+	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence, typename TGatingSequences>
+	struct sequencer_traits<BufferSize, TWaitStrategy, TSequence, producer_type::single, TGatingSequences>
 	{
 		typedef TWaitStrategy wait_strategy_type;
 		typedef TSequence sequence_type;
-		typedef single_producer_sequencer<BufferSize, TWaitStrategy, TSequence> sequencer_type;
+		typedef TGatingSequences gating_sequences_type;
+		typedef single_producer_sequencer<BufferSize, TWaitStrategy, TSequence, TGatingSequences> sequencer_type;
 		typedef sequence_barrier<sequencer_type> sequence_barrier_type;
 
 		static constexpr std::size_t BUFFER_SIZE = BufferSize;
 		static constexpr producer_type PRODUCER_TYPE = producer_type::single;
 	};
 
-	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence>
-	struct sequencer_traits<BufferSize, TWaitStrategy, TSequence, producer_type::multi>
+	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence, typename TGatingSequences>
+	struct sequencer_traits<BufferSize, TWaitStrategy, TSequence, producer_type::multi, TGatingSequences>
 	{
 		typedef TWaitStrategy wait_strategy_type;
 		typedef TSequence sequence_type;
-		typedef multi_producer_sequencer<BufferSize, TWaitStrategy, TSequence> sequencer_type;
+		typedef TGatingSequences gating_sequences_type;
+		typedef multi_producer_sequencer<BufferSize, TWaitStrategy, TSequence, TGatingSequences> sequencer_type;
 		typedef sequence_barrier<sequencer_type> sequence_barrier_type;
 
 		static constexpr std::size_t BUFFER_SIZE = BufferSize;
 		static constexpr producer_type PRODUCER_TYPE = producer_type::multi;
 	};
+
+	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence, typename TGatingSequences>
+	struct sequencer_traits<BufferSize, TWaitStrategy, TSequence, producer_type::multi_fetch_add, TGatingSequences>
+	{
+		typedef TWaitStrategy wait_strategy_type;
+		typedef TSequence sequence_type;
+		typedef TGatingSequences gating_sequences_type;
+		typedef multi_producer_sequencer<BufferSize, TWaitStrategy, TSequence,
+			TGatingSequences, claim_strategy::fetch_add> sequencer_type;
+		typedef sequence_barrier<sequencer_type> sequence_barrier_type;
+
+		static constexpr std::size_t BUFFER_SIZE = BufferSize;
+		static constexpr producer_type PRODUCER_TYPE = producer_type::multi_fetch_add;
+	};
 }
 
 #endif
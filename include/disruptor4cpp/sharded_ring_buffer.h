@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_SHARDED_RING_BUFFER_H_
+#define DISRUPTOR4CPP_SHARDED_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+#include "exceptions/insufficient_capacity_exception.h"
+#include "utils/cache_line_storage.h"
+
+namespace disruptor4cpp
+{
+	struct shard_metrics
+	{
+		// The shard cursor + 1: the sequences published so far on a single producer shard, or
+		// claimed so far (possibly not yet published) on a multi producer shard.
+		int64_t claimed;
+		int64_t remaining_capacity;
+		// try_publish_event calls that found the shard full.
+		uint64_t rejected;
+	};
+
+	// N independent ring buffers behind a router that picks the shard from a hash of the event
+	// key. Events with the same key always go to the same shard, so their order is preserved,
+	// while producers of different keys no longer contend on a single cursor. Each shard is an
+	// ordinary ring buffer with its own barriers and processors.
+	template <typename TRingBuffer, std::size_t ShardCount>
+	class sharded_ring_buffer
+	{
+	public:
+		static_assert(ShardCount > 0, "ShardCount must be > 0");
+
+		typedef TRingBuffer ring_buffer_type;
+		typedef typename TRingBuffer::event_type event_type;
+
+		static constexpr std::size_t SHARD_COUNT = ShardCount;
+
+		sharded_ring_buffer()
+			: shards_()
+		{
+			for (auto& rejected : rejected_)
+				rejected.data.store(0, std::memory_order_relaxed);
+		}
+
+		~sharded_ring_buffer() = default;
+
+		TRingBuffer& get_shard(std::size_t index)
+		{
+			return shards_[index];
+		}
+
+		const TRingBuffer& get_shard(std::size_t index) const
+		{
+			return shards_[index];
+		}
+
+		constexpr std::size_t get_shard_count() const
+		{
+			return ShardCount;
+		}
+
+		template <typename TKey, typename THash = std::hash<TKey>>
+		std::size_t get_shard_index(const TKey& key) const
+		{
+			return mix(static_cast<uint64_t>(THash()(key))) % ShardCount;
+		}
+
+		// Claims the next slot of the key's shard, lets the translator fill it in with
+		// (event_type& event, int64_t sequence), then publishes it. The slot is published even
+		// if the translator throws, as a claimed sequence must not be left unpublished.
+		template <typename TKey, typename TTranslator>
+		int64_t publish_event(const TKey& key, TTranslator&& translator)
+		{
+			TRingBuffer& shard = shards_[get_shard_index(key)];
+			return translate_and_publish(shard, shard.next(), translator);
+		}
+
+		// As publish_event, but throws insufficient_capacity_exception if the shard is full.
+		template <typename TKey, typename TTranslator>
+		int64_t try_publish_event(const TKey& key, TTranslator&& translator)
+		{
+			const std::size_t index = get_shard_index(key);
+			int64_t seq;
+			try
+			{
+				seq = shards_[index].try_next();
+			}
+			catch (insufficient_capacity_exception&)
+			{
+				rejected_[index].data.fetch_add(1, std::memory_order_relaxed);
+				throw;
+			}
+			return translate_and_publish(shards_[index], seq, translator);
+		}
+
+		// Sum over the shards. A single key can only use the capacity of its own shard.
+		int64_t remaining_capacity() const
+		{
+			int64_t capacity = 0;
+			for (const auto& shard : shards_)
+				capacity += shard.remaining_capacity();
+			return capacity;
+		}
+
+		shard_metrics get_metrics(std::size_t index) const
+		{
+			shard_metrics metrics;
+			metrics.claimed = shards_[index].get_cursor() + 1;
+			metrics.remaining_capacity = shards_[index].remaining_capacity();
+			metrics.rejected = rejected_[index].data.load(std::memory_order_relaxed);
+			return metrics;
+		}
+
+	private:
+		sharded_ring_buffer(const sharded_ring_buffer&) = delete;
+		sharded_ring_buffer& operator=(const sharded_ring_buffer&) = delete;
+		sharded_ring_buffer(sharded_ring_buffer&&) = delete;
+		sharded_ring_buffer& operator=(sharded_ring_buffer&&) = delete;
+
+		// std::hash is the identity for integers on common implementations; the finalizer of
+		// MurmurHash3 spreads sequential keys evenly over the shards.
+		static uint64_t mix(uint64_t hash)
+		{
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdULL;
+			hash ^= hash >> 33;
+			hash *= 0xc4ceb9fe1a85ec53ULL;
+			hash ^= hash >> 33;
+			return hash;
+		}
+
+		template <typename TTranslator>
+		static int64_t translate_and_publish(TRingBuffer& shard, int64_t seq, TTranslator& translator)
+		{
+			try
+			{
+				translator(shard[seq], seq);
+			}
+			catch (...)
+			{
+				shard.publish(seq);
+				throw;
+			}
+			shard.publish(seq);
+			return seq;
+		}
+
+		TRingBuffer shards_[ShardCount];
+		cache_line_storage<std::atomic<uint64_t>> rejected_[ShardCount];
+	};
+}
+
+#endif
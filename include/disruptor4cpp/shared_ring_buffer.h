@@ -0,0 +1,196 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_SHARED_RING_BUFFER_H_
+#define DISRUPTOR4CPP_SHARED_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "offset_sequence_list.h"
+#include "producer_type.h"
+#include "ring_buffer.h"
+#include "sequence.h"
+#include "utils/shared_memory_region.h"
+#include "wait_strategies/wait_strategy_traits.h"
+
+namespace disruptor4cpp
+{
+	// A ring buffer placed, together with the sequences of its consumers, in a POSIX shared
+	// memory object, so that producers and consumers can run in different processes.
+	//
+	// One process creates the segment with a fixed number of consumer slots, each gating the
+	// producers. Other processes open it by name; the header records the layout, and opening
+	// fails unless it matches the caller's instantiation. A consumer process builds its
+	// barrier with new_barrier() as usual and passes get_consumer_sequence(i) to its
+	// batch_event_processor. The segment is never destroyed in place; call unlink when done.
+	template <typename TEvent, std::size_t BufferSize, typename TWaitStrategy,
+		producer_type ProducerType, std::size_t MaxConsumers = 8>
+	class shared_ring_buffer
+	{
+	public:
+		static_assert(std::is_trivially_copyable<TEvent>::value,
+			"Event type must be trivially copyable to be shared between processes");
+		static_assert(is_process_shared_wait_strategy<TWaitStrategy>::value,
+			"Wait strategy must work across processes");
+		static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+			"Process-shared atomics must be lock free");
+
+		typedef ring_buffer<TEvent, BufferSize, TWaitStrategy, ProducerType,
+			sequence, offset_sequence_list<sequence, MaxConsumers>> ring_buffer_type;
+
+		static constexpr uint64_t MAGIC = 0x3142524853433444ULL; // "D4CSHRB1"
+		static constexpr uint32_t VERSION = 1;
+
+		static std::unique_ptr<shared_ring_buffer> create(const std::string& name, std::size_t consumer_count)
+		{
+			if (consumer_count > MaxConsumers)
+				throw std::invalid_argument("consumer_count must be <= MaxConsumers");
+
+			std::unique_ptr<shared_ring_buffer> buffer(
+				new shared_ring_buffer(shared_memory_region::create(name, sizeof(layout))));
+			layout* segment = new (buffer->region_.get_address()) layout();
+			segment->header.magic = MAGIC;
+			segment->header.version = VERSION;
+			segment->header.buffer_size = BufferSize;
+			segment->header.event_size = sizeof(TEvent);
+			segment->header.segment_size = sizeof(layout);
+			segment->header.max_consumers = MaxConsumers;
+			segment->header.consumer_count = consumer_count;
+
+			std::vector<sequence*> consumer_sequences;
+			for (std::size_t i = 0; i < consumer_count; i++)
+				consumer_sequences.push_back(&segment->consumer_sequences[i]);
+			segment->ring_buffer.add_gating_sequences(consumer_sequences);
+
+			segment->header.state.store(STATE_READY, std::memory_order_release);
+			buffer->segment_ = segment;
+			return buffer;
+		}
+
+		// Throws std::runtime_error if the segment is not fully created yet or was created
+		// with a different layout.
+		static std::unique_ptr<shared_ring_buffer> open(const std::string& name)
+		{
+			std::unique_ptr<shared_ring_buffer> buffer(
+				new shared_ring_buffer(shared_memory_region::open(name)));
+			if (buffer->region_.get_size() < sizeof(layout))
+				throw std::runtime_error("shared ring buffer is not initialized or too small");
+
+			layout* segment = static_cast<layout*>(buffer->region_.get_address());
+			if (segment->header.state.load(std::memory_order_acquire) != STATE_READY)
+				throw std::runtime_error("shared ring buffer is not initialized");
+			if (segment->header.magic != MAGIC || segment->header.version != VERSION)
+				throw std::runtime_error("shared ring buffer has an unknown format");
+			if (segment->header.buffer_size != BufferSize
+				|| segment->header.event_size != sizeof(TEvent)
+				|| segment->header.segment_size != sizeof(layout)
+				|| segment->header.max_consumers != MaxConsumers)
+				throw std::runtime_error("shared ring buffer layout does not match");
+
+			buffer->segment_ = segment;
+			return buffer;
+		}
+
+		static void unlink(const std::string& name)
+		{
+			shared_memory_region::unlink(name);
+		}
+
+		~shared_ring_buffer() = default;
+
+		ring_buffer_type& get_ring_buffer()
+		{
+			return segment_->ring_buffer;
+		}
+
+		std::size_t get_consumer_count() const
+		{
+			return segment_->header.consumer_count;
+		}
+
+		sequence& get_consumer_sequence(std::size_t index)
+		{
+			if (index >= segment_->header.consumer_count)
+				throw std::out_of_range("index must be < consumer count");
+			return segment_->consumer_sequences[index];
+		}
+
+		const shared_memory_region& get_region() const
+		{
+			return region_;
+		}
+
+	private:
+		shared_ring_buffer(const shared_ring_buffer&) = delete;
+		shared_ring_buffer& operator=(const shared_ring_buffer&) = delete;
+		shared_ring_buffer(shared_ring_buffer&&) = delete;
+		shared_ring_buffer& operator=(shared_ring_buffer&&) = delete;
+
+		static constexpr uint32_t STATE_READY = 1;
+
+		struct segment_header
+		{
+			uint64_t magic;
+			uint32_t version;
+			std::atomic<uint32_t> state;
+			uint64_t buffer_size;
+			uint64_t event_size;
+			uint64_t segment_size;
+			uint64_t max_consumers;
+			uint64_t consumer_count;
+		};
+
+		struct layout
+		{
+			segment_header header;
+			sequence consumer_sequences[MaxConsumers];
+			ring_buffer_type ring_buffer;
+		};
+
+		explicit shared_ring_buffer(shared_memory_region&& region)
+			: region_(std::move(region)),
+			  segment_(nullptr)
+		{
+		}
+
+		shared_memory_region region_;
+		layout* segment_;
+	};
+}
+
+#endif
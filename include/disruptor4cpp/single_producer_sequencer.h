@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef DISRUPTOR4CPP_SINGLE_PRODUCER_SEQUENCER_H_
 #define DISRUPTOR4CPP_SINGLE_PRODUCER_SEQUENCER_H_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -41,18 +42,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "exceptions/insufficient_capacity_exception.h"
 #include "sequence.h"
 #include "sequence_barrier.h"
+#include "static_sequence_group.h"
+#include "utils/cache_line_storage.h"
+#include "utils/tracepoint.h"
 #include "utils/util.h"
 
 namespace disruptor4cpp
 {
-	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence = sequence>
+	template <std::size_t BufferSize, typename TWaitStrategy, typename TSequence = sequence,
+		typename TGatingSequences = std::vector<TSequence*>>
 	class single_producer_sequencer
 	{
 	public:
 		typedef TWaitStrategy wait_strategy_type;
 		typedef TSequence sequence_type;
+		typedef TGatingSequences gating_sequences_type;
 		typedef sequence_barrier<
-			single_producer_sequencer<BufferSize, TWaitStrategy, TSequence>> sequence_barrier_type;
+			single_producer_sequencer<BufferSize, TWaitStrategy, TSequence, TGatingSequences>> sequence_barrier_type;
+		template <std::size_t N>
+		using static_sequence_barrier_type = sequence_barrier<
+			single_producer_sequencer<BufferSize, TWaitStrategy, TSequence, TGatingSequences>, static_sequence_group<TSequence, N>>;
 
 		static constexpr int64_t INITIAL_CURSOR_VALUE = -1;
 		static constexpr std::size_t BUFFER_SIZE = BufferSize;
@@ -80,7 +89,7 @@ namespace disruptor4cpp
 
 		TWaitStrategy& get_wait_strategy()
 		{
-			return wait_strategy_;
+			return wait_strategy_.data;
 		}
 
 		void add_gating_sequences(const std::vector<TSequence*>& sequences_to_add)
@@ -126,7 +135,16 @@ namespace disruptor4cpp
 		std::unique_ptr<sequence_barrier_type> new_barrier(const std::vector<TSequence*>& sequences_to_track)
 		{
 			return std::unique_ptr<sequence_barrier_type>(
-				new sequence_barrier_type(*this, wait_strategy_, cursor_, sequences_to_track));
+				new sequence_barrier_type(*this, wait_strategy_.data, cursor_, sequences_to_track));
+		}
+
+		// Barrier over dependencies fixed at compile time, which waits without pointer chasing.
+		template <std::size_t N>
+		std::unique_ptr<static_sequence_barrier_type<N>> new_barrier(const std::array<TSequence*, N>& sequences_to_track)
+		{
+			return std::unique_ptr<static_sequence_barrier_type<N>>(
+				new static_sequence_barrier_type<N>(*this, wait_strategy_.data, cursor_,
+					static_sequence_group<TSequence, N>::create(sequences_to_track)));
 		}
 
 		bool has_available_capacity(int required_capacity)
@@ -169,6 +187,7 @@ namespace disruptor4cpp
 				cached_value_ = min_sequence;
 			}
 			next_value_ = next_sequence;
+			DISRUPTOR4CPP_TRACE3(claim, this, next_sequence - n + 1, next_sequence);
 			return next_sequence;
 		}
 
@@ -185,6 +204,7 @@ namespace disruptor4cpp
 				throw insufficient_capacity_exception();
 
 			int64_t next_sequence = (next_value_ += n);
+			DISRUPTOR4CPP_TRACE3(claim, this, next_sequence - n + 1, next_sequence);
 			return next_sequence;
 		}
 
@@ -203,13 +223,14 @@ namespace disruptor4cpp
 
 		void publish(int64_t seq)
 		{
-			cursor_.set(seq);
-			wait_strategy_.signal_all_when_blocking();
+			publish(seq, seq);
 		}
 
 		void publish(int64_t lo, int64_t hi)
 		{
-			publish(hi);
+			cursor_.set(hi);
+			DISRUPTOR4CPP_TRACE3(publish, this, lo, hi);
+			wait_strategy_.data.signal_all_when_blocking();
 		}
 
 		bool is_available(int64_t seq) const
@@ -229,10 +250,13 @@ namespace disruptor4cpp
 		single_producer_sequencer& operator=(single_producer_sequencer&&) = delete;
 
 		TSequence cursor_;
-		TWaitStrategy wait_strategy_;
-		std::vector<TSequence*> gating_sequences_;
-		int64_t next_value_;
+		cache_line_storage<TWaitStrategy, CACHE_LINE_PADDING_SIZE> wait_strategy_;
+		TGatingSequences gating_sequences_;
+
+		// Producer private state, on its own lines.
+		alignas(CACHE_LINE_PADDING_SIZE) int64_t next_value_;
 		int64_t cached_value_;
+		char padding_[CACHE_LINE_PADDING_SIZE - 2 * sizeof(int64_t)];
 	};
 }
 
@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_STATIC_SEQUENCE_GROUP_H_
+#define DISRUPTOR4CPP_STATIC_SEQUENCE_GROUP_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "sequence.h"
+
+namespace disruptor4cpp
+{
+	// Dependency group whose size is fixed at compile time, for barriers wired once at startup.
+	// The pointers are stored inline, so a barrier holding the group reads only the sequences
+	// themselves, and the minimum is computed without a loop.
+	template <typename TSequence, std::size_t N>
+	class static_sequence_group
+	{
+	public:
+		static_assert(N > 0, "Sequence group must not be empty");
+
+		static static_sequence_group<TSequence, N> create(const std::array<TSequence*, N>& sequences)
+		{
+			static_sequence_group<TSequence, N> group;
+			for (std::size_t i = 0; i < N; i++)
+				group.sequences_[i] = sequences[i];
+			return group;
+		}
+
+		static static_sequence_group<TSequence, N> create(const std::array<const TSequence*, N>& sequences)
+		{
+			static_sequence_group<TSequence, N> group;
+			group.sequences_ = sequences;
+			return group;
+		}
+
+		static_sequence_group() = default;
+		~static_sequence_group() = default;
+
+		int64_t get() const
+		{
+			return get_minimum(sequences_[0]->get(), std::integral_constant<std::size_t, 1>());
+		}
+
+	private:
+		template <std::size_t I>
+		int64_t get_minimum(int64_t minimum, std::integral_constant<std::size_t, I>) const
+		{
+			int64_t value = sequences_[I]->get();
+			return get_minimum(value < minimum ? value : minimum, std::integral_constant<std::size_t, I + 1>());
+		}
+
+		int64_t get_minimum(int64_t minimum, std::integral_constant<std::size_t, N>) const
+		{
+			return minimum;
+		}
+
+		std::array<const TSequence*, N> sequences_;
+	};
+}
+
+#endif
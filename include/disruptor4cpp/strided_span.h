@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_STRIDED_SPAN_H_
+#define DISRUPTOR4CPP_STRIDED_SPAN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace disruptor4cpp
+{
+	// A run of consecutive events that are stride bytes apart. Ring buffer slots are padded to
+	// cache lines, so a span of ring buffer events is not a contiguous array of TEvent: index it
+	// or iterate it, and check is_contiguous() before treating data() as one block, e.g. for
+	// writev or vectorised loops.
+	template <typename TEvent>
+	class strided_span
+	{
+	public:
+		class iterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef TEvent value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef TEvent* pointer;
+			typedef TEvent& reference;
+
+			iterator(char* position, std::size_t stride)
+				: position_(position),
+				  stride_(stride)
+			{
+			}
+
+			TEvent& operator*() const
+			{
+				return *reinterpret_cast<TEvent*>(position_);
+			}
+
+			TEvent* operator->() const
+			{
+				return reinterpret_cast<TEvent*>(position_);
+			}
+
+			iterator& operator++()
+			{
+				position_ += stride_;
+				return *this;
+			}
+
+			iterator operator++(int)
+			{
+				iterator it = *this;
+				position_ += stride_;
+				return it;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				return position_ == other.position_;
+			}
+
+			bool operator!=(const iterator& other) const
+			{
+				return position_ != other.position_;
+			}
+
+		private:
+			char* position_;
+			std::size_t stride_;
+		};
+
+		strided_span()
+			: data_(nullptr),
+			  size_(0),
+			  stride_(sizeof(TEvent))
+		{
+		}
+
+		strided_span(TEvent* data, std::size_t size, std::size_t stride = sizeof(TEvent))
+			: data_(reinterpret_cast<char*>(data)),
+			  size_(size),
+			  stride_(stride)
+		{
+		}
+
+		TEvent& operator[](std::size_t index) const
+		{
+			return *reinterpret_cast<TEvent*>(data_ + index * stride_);
+		}
+
+		TEvent* data() const
+		{
+			return reinterpret_cast<TEvent*>(data_);
+		}
+
+		std::size_t size() const
+		{
+			return size_;
+		}
+
+		std::size_t stride() const
+		{
+			return stride_;
+		}
+
+		// Whether the events are packed, so that data() points to size() adjacent TEvent objects.
+		bool is_contiguous() const
+		{
+			return stride_ == sizeof(TEvent);
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+
+		iterator begin() const
+		{
+			return iterator(data_, stride_);
+		}
+
+		iterator end() const
+		{
+			return iterator(data_ + size_ * stride_, stride_);
+		}
+
+	private:
+		char* data_;
+		std::size_t size_;
+		std::size_t stride_;
+	};
+}
+
+#endif
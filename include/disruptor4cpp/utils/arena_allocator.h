@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_UTILS_ARENA_ALLOCATOR_H_
+#define DISRUPTOR4CPP_UTILS_ARENA_ALLOCATOR_H_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "slab_arena.h"
+
+namespace disruptor4cpp
+{
+	// Allocator drawing from an arena_region, for event members that own heap memory. It never
+	// propagates on assignment or swap, so assigning into an event keeps the event's region and
+	// reuses its capacity, and a copy made outside the ring gets a default allocator, which uses
+	// operator new.
+	template <typename T>
+	class arena_allocator
+	{
+	public:
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+		typedef T value_type;
+		typedef std::false_type propagate_on_container_copy_assignment;
+		typedef std::false_type propagate_on_container_move_assignment;
+		typedef std::false_type propagate_on_container_swap;
+
+		template <typename U>
+		struct rebind
+		{
+			typedef arena_allocator<U> other;
+		};
+
+		arena_allocator() noexcept
+			: region_(nullptr)
+		{
+		}
+
+		explicit arena_allocator(arena_region& region) noexcept
+			: region_(&region)
+		{
+		}
+
+		template <typename U>
+		arena_allocator(const arena_allocator<U>& other) noexcept
+			: region_(other.get_region())
+		{
+		}
+
+		T* allocate(std::size_t n)
+		{
+			if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+				throw std::bad_alloc();
+			return static_cast<T*>(region_ != nullptr
+				? region_->allocate(n * sizeof(T), alignof(T)) : ::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, std::size_t n)
+		{
+			if (region_ != nullptr)
+				region_->deallocate(ptr, n * sizeof(T));
+			else
+				::operator delete(ptr);
+		}
+
+		arena_allocator select_on_container_copy_construction() const
+		{
+			return arena_allocator();
+		}
+
+		arena_region* get_region() const noexcept
+		{
+			return region_;
+		}
+
+	private:
+		arena_region* region_;
+	};
+
+	template <typename T, typename U>
+	bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+	{
+		return lhs.get_region() == rhs.get_region();
+	}
+
+	template <typename T, typename U>
+	bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+	{
+		return lhs.get_region() != rhs.get_region();
+	}
+
+	typedef std::basic_string<char, std::char_traits<char>, arena_allocator<char>> arena_string;
+
+	template <typename T>
+	using arena_vector = std::vector<T, arena_allocator<T>>;
+}
+
+#endif
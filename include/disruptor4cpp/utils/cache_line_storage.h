@@ -31,19 +31,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef DISRUPTOR4CPP_UTILS_CACHE_LINE_STORAGE_H_
 #define DISRUPTOR4CPP_UTILS_CACHE_LINE_STORAGE_H_
 
+#include <cstddef>
+
 #ifndef CACHE_LINE_SIZE
 #define CACHE_LINE_SIZE 64
 #endif
 
+// Padding used to isolate fields written by different threads (sequences and the hot
+// sequencer and barrier fields). The adjacent-line prefetcher on Intel fetches cache lines in
+// pairs, so it defaults to two lines. Define it as CACHE_LINE_SIZE for single line padding.
+#ifndef CACHE_LINE_PADDING_SIZE
+#define CACHE_LINE_PADDING_SIZE (2 * CACHE_LINE_SIZE)
+#endif
+
 namespace disruptor4cpp
 {
-	template <typename T>
+	template <typename T, std::size_t PaddingSize = CACHE_LINE_SIZE>
 	struct cache_line_storage
 	{
-		alignas(CACHE_LINE_SIZE) T data;
+		alignas(PaddingSize) T data;
 
 	private:
-		char padding[CACHE_LINE_SIZE > sizeof(T) ? CACHE_LINE_SIZE - sizeof(T) : 1];
+		char padding[PaddingSize > sizeof(T) ? PaddingSize - sizeof(T) : 1];
 	};
 }
 
@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_UTILS_CRC32C_H_
+#define DISRUPTOR4CPP_UTILS_CRC32C_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DISRUPTOR4CPP_CRC32C_X86 1
+#include <nmmintrin.h>
+#endif
+
+namespace disruptor4cpp
+{
+	// CRC-32C (Castagnoli), as used by iSCSI, ext4 and most journals. Uses the SSE4.2 crc32
+	// instruction when the CPU has it, otherwise a table driven implementation.
+	class crc32c
+	{
+	public:
+		static uint32_t compute(const void* data, std::size_t length)
+		{
+			return update(0, data, length);
+		}
+
+		// Continues a checksum; update(update(0, a), b) == compute(a + b).
+		static uint32_t update(uint32_t crc, const void* data, std::size_t length)
+		{
+#ifdef DISRUPTOR4CPP_CRC32C_X86
+			if (has_hardware_support())
+				return ~update_hardware(~crc, static_cast<const uint8_t*>(data), length);
+#endif
+			return ~update_software(~crc, static_cast<const uint8_t*>(data), length);
+		}
+
+		static bool has_hardware_support()
+		{
+#ifdef DISRUPTOR4CPP_CRC32C_X86
+			static const bool supported = __builtin_cpu_supports("sse4.2");
+			return supported;
+#else
+			return false;
+#endif
+		}
+
+		static uint32_t update_software(uint32_t crc, const uint8_t* data, std::size_t length)
+		{
+			static const table lookup;
+			for (std::size_t i = 0; i < length; i++)
+				crc = lookup.values[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+			return crc;
+		}
+
+#ifdef DISRUPTOR4CPP_CRC32C_X86
+		__attribute__((target("sse4.2")))
+		static uint32_t update_hardware(uint32_t crc, const uint8_t* data, std::size_t length)
+		{
+#ifdef __x86_64__
+			uint64_t crc64 = crc;
+			for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t), data += sizeof(uint64_t))
+			{
+				uint64_t word;
+				std::memcpy(&word, data, sizeof(word));
+				crc64 = _mm_crc32_u64(crc64, word);
+			}
+			crc = static_cast<uint32_t>(crc64);
+#endif
+			for (; length >= sizeof(uint32_t); length -= sizeof(uint32_t), data += sizeof(uint32_t))
+			{
+				uint32_t word;
+				std::memcpy(&word, data, sizeof(word));
+				crc = _mm_crc32_u32(crc, word);
+			}
+			for (; length > 0; length--, data++)
+				crc = _mm_crc32_u8(crc, *data);
+			return crc;
+		}
+#endif
+
+	private:
+		static constexpr uint32_t POLYNOMIAL = 0x82f63b78; // reflected 0x1edc6f41
+
+		struct table
+		{
+			table()
+			{
+				for (uint32_t i = 0; i < 256; i++)
+				{
+					uint32_t crc = i;
+					for (int bit = 0; bit < 8; bit++)
+						crc = (crc & 1) ? (crc >> 1) ^ POLYNOMIAL : crc >> 1;
+					values[i] = crc;
+				}
+			}
+
+			uint32_t values[256];
+		};
+	};
+}
+
+#endif
@@ -0,0 +1,190 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_UTILS_MAPPED_FILE_H_
+#define DISRUPTOR4CPP_UTILS_MAPPED_FILE_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace disruptor4cpp
+{
+	// A regular file mapped into memory in full. The mapping is released on destruction.
+	class mapped_file
+	{
+	public:
+		// Creates a new file with all of its blocks allocated up front, so that writes through
+		// the mapping never extend the file. Fails if the file exists.
+		static mapped_file create(const std::string& path, std::size_t size)
+		{
+			int fd = ::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+			if (fd == -1)
+				throw_system_error("open");
+			int error = ::posix_fallocate(fd, 0, size);
+			if (error != 0)
+			{
+				::close(fd);
+				::unlink(path.c_str());
+				throw std::system_error(error, std::system_category(), "posix_fallocate");
+			}
+			try
+			{
+				return mapped_file(path, fd, size, PROT_READ | PROT_WRITE);
+			}
+			catch (...)
+			{
+				::unlink(path.c_str());
+				throw;
+			}
+		}
+
+		static mapped_file open_read_only(const std::string& path)
+		{
+			int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd == -1)
+				throw_system_error("open");
+			struct stat status;
+			if (::fstat(fd, &status) == -1)
+			{
+				int error = errno;
+				::close(fd);
+				throw std::system_error(error, std::system_category(), "fstat");
+			}
+			return mapped_file(path, fd, status.st_size, PROT_READ);
+		}
+
+		// Makes a directory entry created or removed in it durable.
+		static void sync_directory(const std::string& path)
+		{
+			int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+			if (fd == -1)
+				throw_system_error("open");
+			int result = ::fsync(fd);
+			int error = errno;
+			::close(fd);
+			if (result == -1)
+				throw std::system_error(error, std::system_category(), "fsync");
+		}
+
+		mapped_file(mapped_file&& other)
+			: path_(std::move(other.path_)),
+			  data_(other.data_),
+			  size_(other.size_)
+		{
+			other.data_ = nullptr;
+			other.size_ = 0;
+		}
+
+		~mapped_file()
+		{
+			if (data_ != nullptr)
+				::munmap(data_, size_);
+		}
+
+		const std::string& get_path() const
+		{
+			return path_;
+		}
+
+		uint8_t* get_data() const
+		{
+			return data_;
+		}
+
+		std::size_t get_size() const
+		{
+			return size_;
+		}
+
+		// Writes back the pages holding [offset, offset + length) and waits for the device.
+		void sync(std::size_t offset, std::size_t length)
+		{
+			const std::size_t page_offset = offset & ~(page_size() - 1);
+			if (::msync(data_ + page_offset, offset + length - page_offset, MS_SYNC) == -1)
+				throw_system_error("msync");
+		}
+
+		// Hints the kernel about the access pattern, e.g. MADV_SEQUENTIAL or MADV_WILLNEED.
+		void advise(int advice)
+		{
+			if (size_ != 0 && ::madvise(data_, size_, advice) == -1)
+				throw_system_error("madvise");
+		}
+
+	private:
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+		mapped_file& operator=(mapped_file&&) = delete;
+
+		mapped_file(const std::string& path, int fd, std::size_t size, int protection)
+			: path_(path),
+			  data_(nullptr),
+			  size_(size)
+		{
+			if (size == 0)
+			{
+				::close(fd);
+				return;
+			}
+			void* data = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+			int error = errno;
+			::close(fd);
+			if (data == MAP_FAILED)
+				throw std::system_error(error, std::system_category(), "mmap");
+			data_ = static_cast<uint8_t*>(data);
+		}
+
+		static std::size_t page_size()
+		{
+			static const std::size_t size = ::sysconf(_SC_PAGESIZE);
+			return size;
+		}
+
+		static void throw_system_error(const char* what)
+		{
+			throw std::system_error(errno, std::system_category(), what);
+		}
+
+		std::string path_;
+		uint8_t* data_;
+		std::size_t size_;
+	};
+}
+
+#endif
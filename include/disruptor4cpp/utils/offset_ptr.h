@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_UTILS_OFFSET_PTR_H_
+#define DISRUPTOR4CPP_UTILS_OFFSET_PTR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace disruptor4cpp
+{
+	// Pointer stored as the distance from itself to the target, so that it stays valid when the
+	// memory holding both is mapped at different addresses in different processes.
+	// An offset of 1 means null, as a pointer to the middle of itself is never useful.
+	template <typename T>
+	class offset_ptr
+	{
+	public:
+		offset_ptr()
+			: offset_(NULL_OFFSET)
+		{
+		}
+
+		offset_ptr(T* ptr)
+			: offset_(to_offset(ptr))
+		{
+		}
+
+		offset_ptr(const offset_ptr& other)
+			: offset_(to_offset(other.get()))
+		{
+		}
+
+		offset_ptr& operator=(const offset_ptr& other)
+		{
+			offset_ = to_offset(other.get());
+			return *this;
+		}
+
+		offset_ptr& operator=(T* ptr)
+		{
+			offset_ = to_offset(ptr);
+			return *this;
+		}
+
+		~offset_ptr() = default;
+
+		T* get() const
+		{
+			return offset_ == NULL_OFFSET ? nullptr
+				: reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + offset_);
+		}
+
+		T& operator*() const
+		{
+			return *get();
+		}
+
+		T* operator->() const
+		{
+			return get();
+		}
+
+		explicit operator bool() const
+		{
+			return offset_ != NULL_OFFSET;
+		}
+
+		friend bool operator==(const offset_ptr& lhs, const T* rhs)
+		{
+			return lhs.get() == rhs;
+		}
+
+		friend bool operator!=(const offset_ptr& lhs, const T* rhs)
+		{
+			return lhs.get() != rhs;
+		}
+
+	private:
+		static constexpr std::ptrdiff_t NULL_OFFSET = 1;
+
+		std::ptrdiff_t to_offset(const T* ptr) const
+		{
+			return ptr == nullptr ? NULL_OFFSET
+				: reinterpret_cast<std::intptr_t>(ptr) - reinterpret_cast<std::intptr_t>(this);
+		}
+
+		std::ptrdiff_t offset_;
+	};
+}
+
+#endif
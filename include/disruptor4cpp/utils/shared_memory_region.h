@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_UTILS_SHARED_MEMORY_REGION_H_
+#define DISRUPTOR4CPP_UTILS_SHARED_MEMORY_REGION_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace disruptor4cpp
+{
+	// A POSIX shared memory object (shm_open) mapped into this process. The mapping is released
+	// on destruction; the name is only removed by unlink.
+	class shared_memory_region
+	{
+	public:
+		// Creates a new object of the given size, failing if the name already exists.
+		static shared_memory_region create(const std::string& name, std::size_t size)
+		{
+			int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd == -1)
+				throw_system_error("shm_open");
+			if (::ftruncate(fd, size) == -1)
+			{
+				int error = errno;
+				::close(fd);
+				::shm_unlink(name.c_str());
+				throw std::system_error(error, std::system_category(), "ftruncate");
+			}
+			try
+			{
+				return shared_memory_region(name, fd, size);
+			}
+			catch (...)
+			{
+				::shm_unlink(name.c_str());
+				throw;
+			}
+		}
+
+		// Maps an existing object in full.
+		static shared_memory_region open(const std::string& name)
+		{
+			int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+			if (fd == -1)
+				throw_system_error("shm_open");
+			struct stat status;
+			if (::fstat(fd, &status) == -1)
+			{
+				int error = errno;
+				::close(fd);
+				throw std::system_error(error, std::system_category(), "fstat");
+			}
+			return shared_memory_region(name, fd, status.st_size);
+		}
+
+		static void unlink(const std::string& name)
+		{
+			if (::shm_unlink(name.c_str()) == -1 && errno != ENOENT)
+				throw_system_error("shm_unlink");
+		}
+
+		shared_memory_region(shared_memory_region&& other)
+			: name_(std::move(other.name_)),
+			  address_(other.address_),
+			  size_(other.size_)
+		{
+			other.address_ = nullptr;
+			other.size_ = 0;
+		}
+
+		~shared_memory_region()
+		{
+			if (address_ != nullptr)
+				::munmap(address_, size_);
+		}
+
+		const std::string& get_name() const
+		{
+			return name_;
+		}
+
+		void* get_address() const
+		{
+			return address_;
+		}
+
+		std::size_t get_size() const
+		{
+			return size_;
+		}
+
+	private:
+		shared_memory_region(const shared_memory_region&) = delete;
+		shared_memory_region& operator=(const shared_memory_region&) = delete;
+		shared_memory_region& operator=(shared_memory_region&&) = delete;
+
+		shared_memory_region(const std::string& name, int fd, std::size_t size)
+			: name_(name),
+			  address_(nullptr),
+			  size_(size)
+		{
+			void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			int error = errno;
+			::close(fd);
+			if (address == MAP_FAILED)
+				throw std::system_error(error, std::system_category(), "mmap");
+			address_ = address;
+		}
+
+		static void throw_system_error(const char* what)
+		{
+			throw std::system_error(errno, std::system_category(), what);
+		}
+
+		std::string name_;
+		void* address_;
+		std::size_t size_;
+	};
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_UTILS_SLAB_ARENA_H_
+#define DISRUPTOR4CPP_UTILS_SLAB_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "cache_line_storage.h"
+
+namespace disruptor4cpp
+{
+	// Bump allocator over a fixed region. Freeing the most recent allocation rolls the top back,
+	// so a container that keeps replacing its last buffer reuses the space; other frees are
+	// no-ops until the region is reset. When the region is exhausted, allocations fall back to
+	// operator new and are counted in get_upstream_allocations().
+	class arena_region
+	{
+	public:
+		arena_region()
+			: begin_(nullptr),
+			  top_(nullptr),
+			  end_(nullptr),
+			  upstream_allocations_(0)
+		{
+		}
+
+		arena_region(char* begin, std::size_t size)
+			: begin_(begin),
+			  top_(begin),
+			  end_(begin + size),
+			  upstream_allocations_(0)
+		{
+		}
+
+		~arena_region() = default;
+
+		void* allocate(std::size_t size, std::size_t alignment)
+		{
+			const std::uintptr_t top = reinterpret_cast<std::uintptr_t>(top_);
+			const std::uintptr_t aligned = (top + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+			if (begin_ != nullptr && aligned + size <= reinterpret_cast<std::uintptr_t>(end_))
+			{
+				top_ = reinterpret_cast<char*>(aligned + size);
+				return reinterpret_cast<void*>(aligned);
+			}
+			upstream_allocations_++;
+			return ::operator new(size);
+		}
+
+		void deallocate(void* ptr, std::size_t size)
+		{
+			if (!contains(ptr))
+			{
+				::operator delete(ptr);
+				return;
+			}
+			if (static_cast<char*>(ptr) + size == top_)
+				top_ = static_cast<char*>(ptr);
+		}
+
+		// Only valid once nothing allocated from the region is in use any more.
+		void reset()
+		{
+			top_ = begin_;
+		}
+
+		bool contains(const void* ptr) const
+		{
+			const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+			return address >= reinterpret_cast<std::uintptr_t>(begin_)
+				&& address < reinterpret_cast<std::uintptr_t>(end_);
+		}
+
+		std::size_t get_used() const
+		{
+			return top_ - begin_;
+		}
+
+		std::size_t get_capacity() const
+		{
+			return end_ - begin_;
+		}
+
+		uint64_t get_upstream_allocations() const
+		{
+			return upstream_allocations_;
+		}
+
+	private:
+		arena_region(const arena_region&) = delete;
+		arena_region& operator=(const arena_region&) = delete;
+
+		char* begin_;
+		char* top_;
+		char* end_;
+		uint64_t upstream_allocations_;
+	};
+
+	// One allocation split into a region per ring buffer slot, each rounded up to whole cache
+	// lines, so that the payload of an event lives next to nothing but its own.
+	class slab_arena
+	{
+	public:
+		slab_arena(std::size_t slot_count, std::size_t region_size)
+			: region_size_((region_size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE),
+			  slab_(new char[slot_count * region_size_ + CACHE_LINE_SIZE]),
+			  regions_(slot_count)
+		{
+			if (slot_count == 0 || region_size == 0)
+				throw std::invalid_argument("slot_count and region_size must be > 0");
+			std::uintptr_t base = (reinterpret_cast<std::uintptr_t>(slab_.get()) + CACHE_LINE_SIZE - 1)
+				& ~static_cast<std::uintptr_t>(CACHE_LINE_SIZE - 1);
+			for (std::size_t i = 0; i < slot_count; i++)
+				regions_[i].reset(new arena_region(reinterpret_cast<char*>(base + i * region_size_), region_size_));
+		}
+
+		~slab_arena() = default;
+
+		arena_region& get_region(std::size_t index)
+		{
+			return *regions_[index];
+		}
+
+		std::size_t get_region_count() const
+		{
+			return regions_.size();
+		}
+
+		std::size_t get_region_size() const
+		{
+			return region_size_;
+		}
+
+		uint64_t get_upstream_allocations() const
+		{
+			uint64_t count = 0;
+			for (const auto& region : regions_)
+				count += region->get_upstream_allocations();
+			return count;
+		}
+
+	private:
+		slab_arena(const slab_arena&) = delete;
+		slab_arena& operator=(const slab_arena&) = delete;
+		slab_arena(slab_arena&&) = delete;
+		slab_arena& operator=(slab_arena&&) = delete;
+
+		std::size_t region_size_;
+		std::unique_ptr<char[]> slab_;
+		std::vector<std::unique_ptr<arena_region>> regions_;
+	};
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_UTILS_TRACEPOINT_H_
+#define DISRUPTOR4CPP_UTILS_TRACEPOINT_H_
+
+// Static (USDT) tracepoints under the "disruptor4cpp" provider, which perf, bpftrace and
+// systemtap can attach to at runtime. They are only emitted when DISRUPTOR4CPP_ENABLE_USDT
+// is defined (see the DISRUPTOR4CPP_USDT CMake option) and otherwise compile to nothing,
+// without evaluating their arguments.
+//
+// Probes:
+//   claim(sequencer, lo, hi)          - sequences [lo, hi] claimed by next() / try_next()
+//   publish(sequencer, lo, hi)        - sequences [lo, hi] made visible to consumers
+//   wait_begin(barrier, seq)          - a consumer starts waiting for seq
+//   wait_end(barrier, seq, available) - the wait for seq returned available
+//   batch_begin(processor, lo, hi)    - a processor starts handling [lo, hi]
+//   batch_end(processor, hi)          - a processor has handled and released up to hi
+
+#if defined(DISRUPTOR4CPP_ENABLE_USDT)
+
+#include <sys/sdt.h>
+
+#define DISRUPTOR4CPP_TRACE2(name, arg1, arg2) \
+	DTRACE_PROBE2(disruptor4cpp, name, arg1, arg2)
+#define DISRUPTOR4CPP_TRACE3(name, arg1, arg2, arg3) \
+	DTRACE_PROBE3(disruptor4cpp, name, arg1, arg2, arg3)
+
+#else
+
+#define DISRUPTOR4CPP_TRACE2(name, arg1, arg2) ((void)0)
+#define DISRUPTOR4CPP_TRACE3(name, arg1, arg2, arg3) ((void)0)
+
+#endif
+
+#endif
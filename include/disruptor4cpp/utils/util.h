@@ -32,22 +32,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DISRUPTOR4CPP_UTILS_UTIL_H_
 
 #include <climits>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <stdexcept>
 
 namespace disruptor4cpp
 {
 	class util
 	{
 	public:
-		template <typename TSequence>
-		static int64_t get_minimum_sequence(const std::vector<const TSequence*>& sequences)
+		// Works on any range of sequence pointers, e.g. std::vector<TSequence*> or a container of
+		// offset_ptr<TSequence> placed in shared memory.
+		template <typename TSequences>
+		static int64_t get_minimum_sequence(const TSequences& sequences)
 		{
 			return get_minimum_sequence(sequences, LLONG_MAX);
 		}
 
-		template <typename TSequence>
-		static int64_t get_minimum_sequence(const std::vector<const TSequence*>& sequences, int64_t minimum)
+		template <typename TSequences>
+		static int64_t get_minimum_sequence(const TSequences& sequences, int64_t minimum)
 		{
 			for (const auto& seq : sequences)
 			{
@@ -58,22 +61,10 @@ namespace disruptor4cpp
 			return minimum;
 		}
 
-		template <typename TSequence>
-		static int64_t get_minimum_sequence(const std::vector<TSequence*>& sequences)
+		// The smallest power of 2 that is >= value.
+		constexpr static std::size_t next_power_of_two(std::size_t value, std::size_t power = 1)
 		{
-			return get_minimum_sequence(sequences, LLONG_MAX);
-		}
-
-		template <typename TSequence>
-		static int64_t get_minimum_sequence(const std::vector<TSequence*>& sequences, int64_t minimum)
-		{
-			for (const auto& seq : sequences)
-			{
-				int64_t value = seq->get();
-				if (value < minimum)
-					minimum = value;
-			}
-			return minimum;
+			return power >= value ? power : next_power_of_two(value, power * 2);
 		}
 
 		constexpr static int log2(int value)
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_WAIT_STRATEGIES_FUTEX_WAIT_STRATEGY_H_
+#define DISRUPTOR4CPP_WAIT_STRATEGIES_FUTEX_WAIT_STRATEGY_H_
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace disruptor4cpp
+{
+	// Blocking strategy built on a process-shared futex instead of a mutex and condition variable,
+	// so that it keeps working when the ring buffer is placed in memory shared between processes.
+	// Publishers only make the system call when a consumer is actually sleeping.
+	class futex_wait_strategy
+	{
+	public:
+		futex_wait_strategy()
+			: signal_(0),
+			  waiters_(0)
+		{
+		}
+
+		~futex_wait_strategy() = default;
+
+		template <typename TSequenceBarrier, typename TSequence, typename TSequenceGroup>
+		int64_t wait_for(int64_t seq, const TSequence& cursor_sequence,
+			const TSequenceGroup& dependent_sequence,
+			const TSequenceBarrier& seq_barrier)
+		{
+			int64_t available_sequence = 0;
+			while ((available_sequence = cursor_sequence.get()) < seq)
+			{
+				seq_barrier.check_alert();
+				waiters_.fetch_add(1, std::memory_order_seq_cst);
+				// Pairs with the fence in signal_all_when_blocking: either the publisher sees the
+				// waiter, or the waiter sees the published cursor (or alert).
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const int32_t signal = signal_.load(std::memory_order_acquire);
+				if (cursor_sequence.get() < seq && !seq_barrier.is_alerted())
+					futex(FUTEX_WAIT, signal);
+				waiters_.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			while ((available_sequence = dependent_sequence.get()) < seq)
+			{
+				seq_barrier.check_alert();
+			}
+			return available_sequence;
+		}
+
+		void signal_all_when_blocking()
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (waiters_.load(std::memory_order_relaxed) != 0)
+			{
+				signal_.fetch_add(1, std::memory_order_release);
+				futex(FUTEX_WAKE, INT_MAX);
+			}
+		}
+
+	private:
+		futex_wait_strategy(const futex_wait_strategy&) = delete;
+		futex_wait_strategy& operator=(const futex_wait_strategy&) = delete;
+		futex_wait_strategy(futex_wait_strategy&&) = delete;
+		futex_wait_strategy& operator=(futex_wait_strategy&&) = delete;
+
+		static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t), "futex word must be a plain 32-bit integer");
+
+		// Not FUTEX_PRIVATE_FLAG: the word may be mapped by several processes.
+		void futex(int op, int32_t value)
+		{
+			syscall(SYS_futex, reinterpret_cast<int32_t*>(&signal_), op, value, nullptr, nullptr, 0);
+		}
+
+		std::atomic<int32_t> signal_;
+		std::atomic<int32_t> waiters_;
+	};
+}
+
+#endif
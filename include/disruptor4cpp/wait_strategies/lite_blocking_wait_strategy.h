@@ -36,8 +36,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdint>
 #include <mutex>
 
-#include "../fixed_sequence_group.h"
-
 namespace disruptor4cpp
 {
 	class lite_blocking_wait_strategy
@@ -50,9 +48,9 @@ namespace disruptor4cpp
 
 		~lite_blocking_wait_strategy() = default;
 
-		template <typename TSequenceBarrier, typename TSequence>
+		template <typename TSequenceBarrier, typename TSequence, typename TSequenceGroup>
 		int64_t wait_for(int64_t seq, const TSequence& cursor_sequence,
-			const fixed_sequence_group<TSequence>& dependent_sequence,
+			const TSequenceGroup& dependent_sequence,
 			const TSequenceBarrier& seq_barrier)
 		{
 			int64_t available_sequence = 0;
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_WAIT_STRATEGIES_SHARED_WAIT_STRATEGY_H_
+#define DISRUPTOR4CPP_WAIT_STRATEGIES_SHARED_WAIT_STRATEGY_H_
+
+#include <cstdint>
+
+namespace disruptor4cpp
+{
+	// Forwards to a single TWaitStrategy instance per TTag, so that several ring buffers (each
+	// holding its own wait strategy object) signal the same strategy, and a consumer of all of
+	// them, such as priority_event_processor, can block on it.
+	template <typename TWaitStrategy, typename TTag = void>
+	class shared_wait_strategy
+	{
+	public:
+		shared_wait_strategy() = default;
+		~shared_wait_strategy() = default;
+
+		static TWaitStrategy& get_instance()
+		{
+			static TWaitStrategy instance;
+			return instance;
+		}
+
+		template <typename TSequenceBarrier, typename TSequence, typename TSequenceGroup>
+		int64_t wait_for(int64_t seq, const TSequence& cursor_sequence,
+			const TSequenceGroup& dependent_sequence,
+			const TSequenceBarrier& seq_barrier)
+		{
+			return get_instance().wait_for(seq, cursor_sequence, dependent_sequence, seq_barrier);
+		}
+
+		void signal_all_when_blocking()
+		{
+			get_instance().signal_all_when_blocking();
+		}
+
+	private:
+		shared_wait_strategy(const shared_wait_strategy&) = delete;
+		shared_wait_strategy& operator=(const shared_wait_strategy&) = delete;
+		shared_wait_strategy(shared_wait_strategy&&) = delete;
+		shared_wait_strategy& operator=(shared_wait_strategy&&) = delete;
+	};
+}
+
+#endif
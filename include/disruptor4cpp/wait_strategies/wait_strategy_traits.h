@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_WAIT_STRATEGIES_WAIT_STRATEGY_TRAITS_H_
+#define DISRUPTOR4CPP_WAIT_STRATEGIES_WAIT_STRATEGY_TRAITS_H_
+
+#include <cstdint>
+#include <type_traits>
+
+#include "busy_spin_wait_strategy.h"
+#include "phased_backoff_wait_strategy.h"
+#include "sleeping_wait_strategy.h"
+#include "yielding_wait_strategy.h"
+#ifdef __linux__
+#include "futex_wait_strategy.h"
+#endif
+
+namespace disruptor4cpp
+{
+	// Whether a wait strategy still works when it lives in memory shared between processes.
+	// The mutex and condition variable based strategies do not.
+	template <typename TWaitStrategy>
+	struct is_process_shared_wait_strategy : std::false_type
+	{
+	};
+
+	template <>
+	struct is_process_shared_wait_strategy<busy_spin_wait_strategy> : std::true_type
+	{
+	};
+
+	template <int SpinTries>
+	struct is_process_shared_wait_strategy<yielding_wait_strategy<SpinTries>> : std::true_type
+	{
+	};
+
+	template <int Retries>
+	struct is_process_shared_wait_strategy<sleeping_wait_strategy<Retries>> : std::true_type
+	{
+	};
+
+	template <int64_t SpinTimeoutNanoseconds, int64_t YieldTimeoutNanoseconds, typename TFallbackStrategy>
+	struct is_process_shared_wait_strategy<
+		phased_backoff_wait_strategy<SpinTimeoutNanoseconds, YieldTimeoutNanoseconds, TFallbackStrategy>>
+		: is_process_shared_wait_strategy<TFallbackStrategy>
+	{
+	};
+
+#ifdef __linux__
+	template <>
+	struct is_process_shared_wait_strategy<futex_wait_strategy> : std::true_type
+	{
+	};
+#endif
+}
+
+#endif
@@ -0,0 +1,392 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "utils/perf_util.h"
+
+// Microbenchmarks for the sequence primitives.
+//
+// 1. Single threaded cost of get, set, compare_and_set and add_and_get.
+// 2. Contended add_and_get and compare_and_set on one shared sequence with 2..N threads.
+// 3. For each thread placement (same core, SMT sibling, same socket, cross socket):
+//    - ping-pong round trip between two sequences, and
+//    - two threads each updating their own sequence, laid out unpadded, padded to one
+//      cache line and padded to two cache lines (false sharing).
+//
+// Usage: sequence_perf [iterations] [max_threads]
+
+namespace disruptor4cpp
+{
+	namespace perf
+	{
+		class unpadded_sequence
+		{
+		public:
+			unpadded_sequence()
+				: sequence_(sequence::INITIAL_VALUE)
+			{
+			}
+
+			int64_t get() const
+			{
+				return sequence_.load(std::memory_order_acquire);
+			}
+
+			void set(int64_t value)
+			{
+				sequence_.store(value, std::memory_order_release);
+			}
+
+		private:
+			std::atomic<int64_t> sequence_;
+		};
+
+		struct cpu_info
+		{
+			int cpu;
+			int core;
+			int package;
+		};
+
+		class topology
+		{
+		public:
+			topology()
+			{
+				cpu_set_t allowed;
+				CPU_ZERO(&allowed);
+				sched_getaffinity(0, sizeof(allowed), &allowed);
+				for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+				{
+					if (!CPU_ISSET(cpu, &allowed))
+						continue;
+					cpu_info info = { cpu, read_id(cpu, "core_id"), read_id(cpu, "physical_package_id") };
+					cpus_.push_back(info);
+				}
+			}
+
+			// Finds two allowed CPUs matching the predicate; returns false if there are none.
+			bool find_pair(const std::function<bool(const cpu_info&, const cpu_info&)>& predicate,
+				int& first, int& second) const
+			{
+				for (const auto& a : cpus_)
+				{
+					for (const auto& b : cpus_)
+					{
+						if (predicate(a, b))
+						{
+							first = a.cpu;
+							second = b.cpu;
+							return true;
+						}
+					}
+				}
+				return false;
+			}
+
+			static void pin(std::thread& t, int cpu)
+			{
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(cpu, &set);
+				pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+			}
+
+		private:
+			static int read_id(int cpu, const char* name)
+			{
+				char path[128];
+				std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+				std::ifstream in(path);
+				int id = -1;
+				in >> id;
+				return id;
+			}
+
+			std::vector<cpu_info> cpus_;
+		};
+
+		// Spins briefly before yielding, so that placements sharing one CPU still make progress.
+		inline void pause(int& spins)
+		{
+			if (++spins > 100)
+			{
+				spins = 0;
+				std::this_thread::yield();
+			}
+		}
+
+		class sequence_perf
+		{
+		public:
+			sequence_perf(int64_t iterations, int max_threads)
+				: iterations_(iterations),
+				  max_threads_(max_threads)
+			{
+			}
+
+			void run()
+			{
+				run_single_threaded();
+				run_contended();
+				run_placements();
+			}
+
+		private:
+			void run_single_threaded()
+			{
+				std::printf("single threaded (ns/op)\n");
+				sequence seq(0);
+				int64_t sink = 0;
+
+				int64_t start = perf_util::now_nanos();
+				for (int64_t i = 0; i < iterations_; i++)
+					sink += seq.get();
+				report("get", start, iterations_);
+
+				start = perf_util::now_nanos();
+				for (int64_t i = 0; i < iterations_; i++)
+					seq.set(i);
+				report("set", start, iterations_);
+
+				start = perf_util::now_nanos();
+				for (int64_t i = 0; i < iterations_; i++)
+					seq.compare_and_set(i - 1, i);
+				report("compare_and_set", start, iterations_);
+
+				start = perf_util::now_nanos();
+				for (int64_t i = 0; i < iterations_; i++)
+					sink += seq.add_and_get(1);
+				report("add_and_get", start, iterations_);
+
+				if (sink == 42)
+					std::printf("\n");
+			}
+
+			void run_contended()
+			{
+				std::printf("\ncontended on one sequence (ns/op per thread)\n");
+				std::printf("%-8s %16s %16s\n", "threads", "add_and_get", "compare_and_set");
+				for (int threads = 2; threads <= max_threads_; threads++)
+				{
+					double add_nanos = run_threads(threads, [](sequence& seq, int64_t iterations)
+						{
+							for (int64_t i = 0; i < iterations; i++)
+								seq.add_and_get(1);
+						});
+					double cas_nanos = run_threads(threads, [](sequence& seq, int64_t iterations)
+						{
+							for (int64_t i = 0; i < iterations; i++)
+							{
+								int64_t current;
+								do
+								{
+									current = seq.get();
+								}
+								while (!seq.compare_and_set(current, current + 1));
+							}
+						});
+					std::printf("%-8d %16.1f %16.1f\n", threads, add_nanos, cas_nanos);
+				}
+			}
+
+			template <typename TBody>
+			double run_threads(int threads, TBody body)
+			{
+				sequence seq(0);
+				std::atomic<int> ready(0);
+				std::vector<std::thread> workers;
+				std::vector<int64_t> elapsed(threads);
+				for (int t = 0; t < threads; t++)
+				{
+					workers.emplace_back([&, t]
+						{
+							ready.fetch_add(1);
+							while (ready.load() < threads)
+								std::this_thread::yield();
+							int64_t start = perf_util::now_nanos();
+							body(seq, iterations_);
+							elapsed[t] = perf_util::now_nanos() - start;
+						});
+				}
+				double total = 0;
+				for (int t = 0; t < threads; t++)
+				{
+					workers[t].join();
+					total += elapsed[t];
+				}
+				return total / threads / iterations_;
+			}
+
+			void run_placements()
+			{
+				std::printf("\nplacement (ns/op)\n");
+				std::printf("%-14s %8s %14s %14s %14s %14s\n", "placement", "cpus",
+					"ping-pong", "unpadded", "1 line", "2 lines");
+
+				topology topo;
+				run_placement(topo, "same core", [](const cpu_info& a, const cpu_info& b)
+					{ return a.cpu == b.cpu; });
+				run_placement(topo, "smt sibling", [](const cpu_info& a, const cpu_info& b)
+					{ return a.cpu != b.cpu && a.package == b.package && a.core == b.core; });
+				run_placement(topo, "same socket", [](const cpu_info& a, const cpu_info& b)
+					{ return a.package == b.package && a.core != b.core; });
+				run_placement(topo, "cross socket", [](const cpu_info& a, const cpu_info& b)
+					{ return a.package != b.package; });
+			}
+
+			void run_placement(const topology& topo, const char* name,
+				const std::function<bool(const cpu_info&, const cpu_info&)>& predicate)
+			{
+				int first;
+				int second;
+				if (!topo.find_pair(predicate, first, second))
+				{
+					std::printf("%-14s %8s %14s %14s %14s %14s\n", name, "-", "n/a", "n/a", "n/a", "n/a");
+					return;
+				}
+
+				// Automatic storage, as operator new does not honour extended alignment before C++17.
+				unpadded_sequence unpadded[2];
+				basic_sequence<CACHE_LINE_SIZE> one_line[2];
+				basic_sequence<2 * CACHE_LINE_SIZE> two_lines[2];
+
+				char cpus[16];
+				std::snprintf(cpus, sizeof(cpus), "%d,%d", first, second);
+				std::printf("%-14s %8s %14.1f %14.1f %14.1f %14.1f\n", name, cpus,
+					ping_pong(first, second),
+					false_sharing(unpadded, first, second),
+					false_sharing(one_line, first, second),
+					false_sharing(two_lines, first, second));
+			}
+
+			// Round trip of a value through two sequences, one written by each thread.
+			double ping_pong(int first, int second)
+			{
+				basic_sequence<2 * CACHE_LINE_SIZE> seqs[2];
+				const int64_t iterations = iterations_ / 100;
+				auto& ping = seqs[0];
+				auto& pong = seqs[1];
+
+				std::thread ponger([&]
+					{
+						int spins = 0;
+						for (int64_t i = 0; i < iterations; i++)
+						{
+							while (ping.get() != i)
+								pause(spins);
+							pong.set(i);
+						}
+					});
+				topology::pin(ponger, second);
+
+				int64_t elapsed = 0;
+				std::thread pinger([&]
+					{
+						int spins = 0;
+						int64_t start = perf_util::now_nanos();
+						for (int64_t i = 0; i < iterations; i++)
+						{
+							ping.set(i);
+							while (pong.get() != i)
+								pause(spins);
+						}
+						elapsed = perf_util::now_nanos() - start;
+					});
+				topology::pin(pinger, first);
+				pinger.join();
+				ponger.join();
+				return static_cast<double>(elapsed) / iterations;
+			}
+
+			// Each thread repeatedly updates its own element of the array.
+			template <typename TSequence>
+			double false_sharing(TSequence* seqs, int first, int second)
+			{
+				std::atomic<int> ready(0);
+				int64_t elapsed[2] = { 0, 0 };
+				std::thread workers[2];
+				const int cpus[2] = { first, second };
+				for (int t = 0; t < 2; t++)
+				{
+					workers[t] = std::thread([&, t]
+						{
+							ready.fetch_add(1);
+							while (ready.load() < 2)
+								std::this_thread::yield();
+							TSequence& seq = seqs[t];
+							int64_t start = perf_util::now_nanos();
+							for (int64_t i = 0; i < iterations_; i++)
+								seq.set(seq.get() + 1);
+							elapsed[t] = perf_util::now_nanos() - start;
+						});
+					topology::pin(workers[t], cpus[t]);
+				}
+				workers[0].join();
+				workers[1].join();
+				return static_cast<double>(elapsed[0] + elapsed[1]) / 2 / iterations_;
+			}
+
+			void report(const char* name, int64_t start_nanos, int64_t iterations)
+			{
+				std::printf("%-16s %8.2f\n", name,
+					static_cast<double>(perf_util::now_nanos() - start_nanos) / iterations);
+			}
+
+			int64_t iterations_;
+			int max_threads_;
+		};
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int64_t iterations = argc > 1 ? std::atoll(argv[1]) : 10000000;
+	int max_threads = argc > 2 ? std::atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+	if (max_threads < 2)
+		max_threads = 2;
+
+	disruptor4cpp::perf::sequence_perf perf(iterations, max_threads);
+	perf.run();
+	return 0;
+}
@@ -0,0 +1,201 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_PERF_UTILS_PERF_UTIL_H_
+#define DISRUPTOR4CPP_PERF_UTILS_PERF_UTIL_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace disruptor4cpp
+{
+	namespace perf
+	{
+		class perf_util
+		{
+		public:
+			static int64_t now_nanos()
+			{
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+
+			// CPU time consumed by the calling thread.
+			static int64_t thread_cpu_nanos()
+			{
+				timespec ts;
+				clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+				return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+			}
+		};
+
+		template <typename T>
+		struct aligned_deleter
+		{
+			void operator()(T* ptr) const
+			{
+				ptr->~T();
+				std::free(ptr);
+			}
+		};
+
+		template <typename T>
+		using aligned_ptr = std::unique_ptr<T, aligned_deleter<T>>;
+
+		// Heap allocates a default constructed T at its declared alignment, as operator new does
+		// not honour extended alignment before C++17. For objects too large for the stack.
+		template <typename T>
+		aligned_ptr<T> make_aligned()
+		{
+			void* memory;
+			if (posix_memalign(&memory, alignof(T), sizeof(T)) != 0)
+				throw std::bad_alloc();
+			try
+			{
+				return aligned_ptr<T>(new (memory) T());
+			}
+			catch (...)
+			{
+				std::free(memory);
+				throw;
+			}
+		}
+
+		// Per thread CPU usage, sampled at the start and the end of a run on the measured thread.
+		class thread_usage
+		{
+		public:
+			thread_usage()
+				: cpu_nanos_(0),
+				  voluntary_switches_(0),
+				  involuntary_switches_(0)
+			{
+			}
+
+			void start()
+			{
+				cpu_nanos_ = -perf_util::thread_cpu_nanos();
+				sample_switches(-1);
+			}
+
+			void stop()
+			{
+				cpu_nanos_ += perf_util::thread_cpu_nanos();
+				sample_switches(1);
+			}
+
+			int64_t get_cpu_nanos() const
+			{
+				return cpu_nanos_;
+			}
+
+			int64_t get_voluntary_switches() const
+			{
+				return voluntary_switches_;
+			}
+
+			int64_t get_involuntary_switches() const
+			{
+				return involuntary_switches_;
+			}
+
+		private:
+			void sample_switches(int sign)
+			{
+#ifdef RUSAGE_THREAD
+				rusage usage;
+				if (getrusage(RUSAGE_THREAD, &usage) == 0)
+				{
+					voluntary_switches_ += sign * static_cast<int64_t>(usage.ru_nvcsw);
+					involuntary_switches_ += sign * static_cast<int64_t>(usage.ru_nivcsw);
+				}
+#endif
+			}
+
+			int64_t cpu_nanos_;
+			int64_t voluntary_switches_;
+			int64_t involuntary_switches_;
+		};
+
+		// Records raw samples into a pre-sized buffer so that recording does not allocate.
+		class latency_recorder
+		{
+		public:
+			explicit latency_recorder(std::size_t capacity)
+			{
+				samples_.reserve(capacity);
+			}
+
+			void record(int64_t value)
+			{
+				if (samples_.size() < samples_.capacity())
+					samples_.push_back(value);
+			}
+
+			void reset()
+			{
+				samples_.clear();
+			}
+
+			std::size_t count() const
+			{
+				return samples_.size();
+			}
+
+			// Must be called once recording has finished and before querying percentiles.
+			void sort()
+			{
+				std::sort(samples_.begin(), samples_.end());
+			}
+
+			int64_t get_percentile(double percentile) const
+			{
+				if (samples_.empty())
+					return 0;
+				std::size_t index = static_cast<std::size_t>(percentile / 100.0 * (samples_.size() - 1) + 0.5);
+				return samples_[std::min(index, samples_.size() - 1)];
+			}
+
+		private:
+			std::vector<int64_t> samples_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,242 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "utils/perf_util.h"
+
+// Runs one producer and one consumer over each wait strategy at several offered loads and
+// reports the end-to-end latency percentiles together with the CPU time and context switches
+// of the producer and the consumer thread.
+//
+// Usage: wait_strategy_perf [duration_ms] [rate,rate,...]
+//   duration_ms - length of each run in milliseconds (default 1000)
+//   rate        - offered loads in events per second, 1 to 1000000000
+//                 (default 10000,100000,1000000)
+
+namespace disruptor4cpp
+{
+	namespace perf
+	{
+		struct perf_event
+		{
+			int64_t value;
+			int64_t publish_nanos;
+		};
+
+		class latency_handler : public event_handler<perf_event>
+		{
+		public:
+			explicit latency_handler(std::size_t capacity)
+				: recorder_(capacity)
+			{
+			}
+
+			virtual ~latency_handler() = default;
+
+			virtual void on_start()
+			{
+				usage_.start();
+			}
+
+			virtual void on_shutdown()
+			{
+				usage_.stop();
+			}
+
+			virtual void on_event(perf_event& event, int64_t sequence, bool end_of_batch)
+			{
+				recorder_.record(perf_util::now_nanos() - event.publish_nanos);
+			}
+
+			virtual void on_timeout(int64_t sequence) { }
+			virtual void on_event_exception(const std::exception& ex, int64_t sequence, perf_event* event) { }
+			virtual void on_start_exception(const std::exception& ex) { }
+			virtual void on_shutdown_exception(const std::exception& ex) { }
+
+			latency_recorder& get_recorder()
+			{
+				return recorder_;
+			}
+
+			const thread_usage& get_usage() const
+			{
+				return usage_;
+			}
+
+		private:
+			latency_recorder recorder_;
+			thread_usage usage_;
+		};
+
+		class wait_strategy_perf
+		{
+		public:
+			static constexpr std::size_t BUFFER_SIZE = 1024 * 64;
+
+			wait_strategy_perf(int64_t duration_millis, const std::vector<int64_t>& rates)
+				: duration_millis_(duration_millis),
+				  rates_(rates)
+			{
+			}
+
+			void run()
+			{
+				std::printf("%-18s %10s %10s %10s %10s %10s %12s %8s %8s %12s %8s\n",
+					"strategy", "rate/s", "p50(us)", "p99(us)", "p99.9(us)", "max(us)",
+					"cons cpu(ms)", "cons %", "cons cs", "prod cpu(ms)", "prod %");
+				for (int64_t rate : rates_)
+				{
+					run_strategy<busy_spin_wait_strategy>("busy_spin", rate);
+					run_strategy<yielding_wait_strategy<>>("yielding", rate);
+					run_strategy<sleeping_wait_strategy<>>("sleeping", rate);
+					run_strategy<phased_backoff_wait_strategy<1000, 1000000, blocking_wait_strategy>>(
+						"phased_backoff", rate);
+					run_strategy<blocking_wait_strategy>("blocking", rate);
+					run_strategy<lite_blocking_wait_strategy>("lite_blocking", rate);
+					run_strategy<timeout_blocking_wait_strategy<1000000>>("timeout_blocking", rate);
+				}
+			}
+
+		private:
+			template <typename TWaitStrategy>
+			void run_strategy(const char* name, int64_t rate)
+			{
+				typedef ring_buffer<perf_event, BUFFER_SIZE, TWaitStrategy, producer_type::single> ring_buffer_type;
+
+				const int64_t iterations = rate * duration_millis_ / 1000;
+				if (iterations <= 0)
+					return;
+
+				aligned_ptr<ring_buffer_type> ring_buffer = make_aligned<ring_buffer_type>();
+				latency_handler handler(iterations);
+				batch_event_processor<ring_buffer_type> processor(*ring_buffer, ring_buffer->new_barrier(), handler);
+				ring_buffer->add_gating_sequences(
+					std::vector<typename ring_buffer_type::sequence_type*> { &processor.get_sequence() });
+				std::thread consumer([&processor] { processor.run(); });
+				while (!processor.is_running())
+					std::this_thread::yield();
+
+				thread_usage producer_usage;
+				int64_t wall_nanos = 0;
+				std::thread producer([&]
+					{
+						producer_usage.start();
+						publish_paced(*ring_buffer, rate, iterations);
+						producer_usage.stop();
+					});
+				int64_t start_nanos = perf_util::now_nanos();
+				producer.join();
+				while (processor.get_sequence().get() < iterations - 1)
+					std::this_thread::yield();
+				wall_nanos = perf_util::now_nanos() - start_nanos;
+				processor.halt();
+				consumer.join();
+
+				latency_recorder& recorder = handler.get_recorder();
+				recorder.sort();
+				const thread_usage& consumer_usage = handler.get_usage();
+				std::printf("%-18s %10lld %10.1f %10.1f %10.1f %10.1f %12.1f %8.1f %8lld %12.1f %8.1f\n",
+					name, (long long)rate,
+					recorder.get_percentile(50) / 1000.0,
+					recorder.get_percentile(99) / 1000.0,
+					recorder.get_percentile(99.9) / 1000.0,
+					recorder.get_percentile(100) / 1000.0,
+					consumer_usage.get_cpu_nanos() / 1e6,
+					100.0 * consumer_usage.get_cpu_nanos() / wall_nanos,
+					(long long)(consumer_usage.get_voluntary_switches() + consumer_usage.get_involuntary_switches()),
+					producer_usage.get_cpu_nanos() / 1e6,
+					100.0 * producer_usage.get_cpu_nanos() / wall_nanos);
+				std::fflush(stdout);
+			}
+
+			// Publishes at the offered rate. The producer sleeps until the next event is due and then
+			// publishes every event due by then, so pacing does not dominate the producer CPU time.
+			template <typename TRingBuffer>
+			static void publish_paced(TRingBuffer& ring_buffer, int64_t rate, int64_t iterations)
+			{
+				const int64_t interval_nanos = 1000000000LL / rate;
+				const auto start_time = std::chrono::steady_clock::now();
+				for (int64_t i = 0; i < iterations;)
+				{
+					auto due_time = start_time + std::chrono::nanoseconds(i * interval_nanos);
+					std::this_thread::sleep_until(due_time);
+					int64_t due_count = (perf_util::now_nanos()
+						- std::chrono::duration_cast<std::chrono::nanoseconds>(
+							start_time.time_since_epoch()).count()) / interval_nanos + 1;
+					for (; i < iterations && i < due_count; i++)
+					{
+						int64_t seq = ring_buffer.next();
+						perf_event& event = ring_buffer[seq];
+						event.value = i;
+						event.publish_nanos = perf_util::now_nanos();
+						ring_buffer.publish(seq);
+					}
+				}
+			}
+
+			int64_t duration_millis_;
+			std::vector<int64_t> rates_;
+		};
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int64_t duration_millis = argc > 1 ? std::atoll(argv[1]) : 1000;
+	std::vector<int64_t> rates;
+	std::istringstream rate_stream(argc > 2 ? argv[2] : "10000,100000,1000000");
+	std::string rate;
+	while (std::getline(rate_stream, rate, ','))
+	{
+		int64_t value = std::atoll(rate.c_str());
+		// The producer paces on a whole number of nanoseconds per event.
+		if (value < 1 || value > 1000000000LL)
+		{
+			std::fprintf(stderr, "rate must be between 1 and 1000000000 events per second: %s\n", rate.c_str());
+			return 1;
+		}
+		rates.push_back(value);
+	}
+
+	disruptor4cpp::perf::wait_strategy_perf perf(duration_millis, rates);
+	perf.run();
+	return 0;
+}
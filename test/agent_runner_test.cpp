@@ -0,0 +1,212 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+#include "support/stub_event_handler.h"
+#include "utils/count_down_latch.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			class counting_handler : public stub_event_handler<stub_event>
+			{
+			public:
+				explicit counting_handler(count_down_latch* latch = nullptr)
+					: started_(0),
+					  shut_down_(0),
+					  latch_(latch)
+				{
+				}
+
+				virtual void on_start() { started_++; }
+				virtual void on_shutdown() { shut_down_++; }
+
+				virtual void on_event(stub_event& event, int64_t sequence, bool end_of_batch)
+				{
+					values_.push_back(event.get_value());
+					if (latch_ != nullptr)
+						latch_->count_down();
+				}
+
+				std::vector<int> values_;
+				int started_;
+				int shut_down_;
+
+			private:
+				count_down_latch* latch_;
+			};
+
+			class failing_handler : public counting_handler
+			{
+			public:
+				using counting_handler::counting_handler;
+
+				virtual void on_event(stub_event& event, int64_t sequence, bool end_of_batch)
+				{
+					counting_handler::on_event(event, sequence, end_of_batch);
+					if (event.get_value() == 1)
+						throw std::runtime_error("event failed");
+				}
+			};
+		}
+
+		class agent_runner_test : public testing::Test
+		{
+		protected:
+			typedef ring_buffer<stub_event, 8, yielding_wait_strategy<>, producer_type::single> ring_buffer_type;
+			typedef batch_event_processor<ring_buffer_type> processor_type;
+
+			void publish(ring_buffer_type& ring, int count)
+			{
+				for (int i = 0; i < count; i++)
+				{
+					int64_t seq = ring.next();
+					ring[seq].set_value(i);
+					ring.publish(seq);
+				}
+			}
+
+			ring_buffer_type first_ring_;
+			ring_buffer_type second_ring_;
+		};
+
+		TEST_F(agent_runner_test, should_round_robin_with_max_events_per_processor)
+		{
+			counting_handler first_handler;
+			counting_handler second_handler;
+			processor_type first(first_ring_, first_ring_.new_barrier(), first_handler);
+			processor_type second(second_ring_, second_ring_.new_barrier(), second_handler);
+			agent_runner<busy_spin_idle_strategy, 2> runner;
+			runner.add(first);
+			runner.add(second);
+			ASSERT_EQ(2u, runner.size());
+
+			publish(first_ring_, 5);
+			publish(second_ring_, 1);
+			ASSERT_EQ(3, runner.do_work());
+			ASSERT_EQ(1, first.get_sequence().get());
+			ASSERT_EQ(0, second.get_sequence().get());
+			ASSERT_EQ(2, runner.do_work());
+			ASSERT_EQ(1, runner.do_work());
+			ASSERT_EQ(0, runner.do_work());
+			ASSERT_EQ((std::vector<int> { 0, 1, 2, 3, 4 }), first_handler.values_);
+		}
+
+		TEST_F(agent_runner_test, should_run_processors_on_one_thread)
+		{
+			count_down_latch latch(6);
+			counting_handler first_handler(&latch);
+			counting_handler second_handler(&latch);
+			processor_type first(first_ring_, first_ring_.new_barrier(), first_handler);
+			processor_type second(second_ring_, second_ring_.new_barrier(), second_handler);
+			first_ring_.add_gating_sequences({ &first.get_sequence() });
+			second_ring_.add_gating_sequences({ &second.get_sequence() });
+			agent_runner<yielding_idle_strategy> runner;
+			runner.add(first);
+			runner.add(second);
+
+			std::thread runner_thread([&runner] { runner.run(); });
+			publish(first_ring_, 3);
+			publish(second_ring_, 3);
+			ASSERT_TRUE(latch.wait(std::chrono::seconds(5)));
+			runner.halt();
+			runner_thread.join();
+
+			ASSERT_FALSE(runner.is_running());
+			ASSERT_FALSE(first.is_running());
+			ASSERT_EQ(1, first_handler.started_);
+			ASSERT_EQ(1, first_handler.shut_down_);
+			ASSERT_EQ(1, second_handler.shut_down_);
+		}
+
+		TEST_F(agent_runner_test, should_drop_halted_processor_and_keep_running_others)
+		{
+			typedef batch_event_processor<ring_buffer_type, ring_buffer_type::sequence_barrier_type,
+				event_handler<stub_event>, halting_exception_handler> halting_processor_type;
+			count_down_latch latch(5);
+			failing_handler first_handler(&latch);
+			counting_handler second_handler(&latch);
+			halting_processor_type first(first_ring_, first_ring_.new_barrier(), first_handler);
+			processor_type second(second_ring_, second_ring_.new_barrier(), second_handler);
+			first_ring_.add_gating_sequences({ &first.get_sequence() });
+			second_ring_.add_gating_sequences({ &second.get_sequence() });
+			agent_runner<yielding_idle_strategy> runner;
+			runner.add(first);
+			runner.add(second);
+
+			std::thread runner_thread([&runner] { runner.run(); });
+			publish(first_ring_, 3);
+			publish(second_ring_, 3);
+			ASSERT_TRUE(latch.wait(std::chrono::seconds(5)));
+			while (first.is_running())
+				std::this_thread::yield();
+			publish(second_ring_, 2);
+			while (second.get_sequence().get() < 4)
+				std::this_thread::yield();
+			runner.halt();
+			runner_thread.join();
+
+			ASSERT_EQ((std::vector<int> { 0, 1 }), first_handler.values_);
+			ASSERT_EQ(0, first.get_sequence().get());
+			ASSERT_EQ(1, first_handler.shut_down_);
+			ASSERT_EQ((std::vector<int> { 0, 1, 2, 0, 1 }), second_handler.values_);
+			ASSERT_EQ(1, second_handler.shut_down_);
+		}
+
+		TEST(backoff_idle_strategy_test, should_spin_yield_then_park_with_doubling_period)
+		{
+			backoff_idle_strategy<1, 1, 1000, 4000> idle_strategy;
+			idle_strategy.idle(0);
+			idle_strategy.idle(0);
+			ASSERT_EQ(1000, idle_strategy.get_park_period_nanoseconds());
+			idle_strategy.idle(0);
+			ASSERT_EQ(2000, idle_strategy.get_park_period_nanoseconds());
+			idle_strategy.idle(0);
+			idle_strategy.idle(0);
+			ASSERT_EQ(4000, idle_strategy.get_park_period_nanoseconds());
+
+			idle_strategy.idle(1);
+			ASSERT_EQ(1000, idle_strategy.get_park_period_nanoseconds());
+		}
+	}
+}
@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			// Not derived from event_handler: the aggregate only needs the callbacks by name.
+			class tracing_handler final
+			{
+			public:
+				tracing_handler(const std::string& name, std::vector<std::string>& trace, bool fail_on_start = false)
+					: name_(name),
+					  trace_(trace),
+					  fail_on_start_(fail_on_start)
+				{
+				}
+
+				void on_start()
+				{
+					if (fail_on_start_)
+						throw std::runtime_error("start failed");
+					trace_.push_back(name_ + ":start");
+				}
+
+				void on_shutdown() { trace_.push_back(name_ + ":shutdown"); }
+
+				void on_event(stub_event& event, int64_t sequence, bool end_of_batch)
+				{
+					trace_.push_back(name_ + ":" + std::to_string(event.get_value()) + (end_of_batch ? "!" : ""));
+				}
+
+				void on_timeout(int64_t sequence) { trace_.push_back(name_ + ":timeout"); }
+
+				void on_event_exception(const std::exception& ex, int64_t sequence, stub_event* event)
+				{
+					trace_.push_back(name_ + ":event_exception");
+				}
+
+				void on_start_exception(const std::exception& ex) { trace_.push_back(name_ + ":start_exception"); }
+				void on_shutdown_exception(const std::exception& ex) { trace_.push_back(name_ + ":shutdown_exception"); }
+
+			private:
+				std::string name_;
+				std::vector<std::string>& trace_;
+				bool fail_on_start_;
+			};
+
+			typedef aggregate_event_handler<stub_event, tracing_handler, tracing_handler> aggregate_type;
+		}
+
+		TEST(aggregate_event_handler_test, should_call_every_handler_on_each_event_in_order)
+		{
+			std::vector<std::string> trace;
+			tracing_handler journal("journal", trace);
+			tracing_handler logic("logic", trace);
+			aggregate_type aggregate(journal, logic);
+
+			stub_event event(1);
+			aggregate.on_event(event, 0, false);
+			event.set_value(2);
+			aggregate.on_event(event, 1, true);
+			aggregate.on_timeout(1);
+
+			std::vector<std::string> expected { "journal:1", "logic:1", "journal:2!", "logic:2!",
+				"journal:timeout", "logic:timeout" };
+			ASSERT_EQ(expected, trace);
+		}
+
+		TEST(aggregate_event_handler_test, should_isolate_lifecycle_failures)
+		{
+			std::vector<std::string> trace;
+			tracing_handler journal("journal", trace, true);
+			tracing_handler logic("logic", trace);
+			aggregate_type aggregate(journal, logic);
+
+			aggregate.on_start();
+			aggregate.on_shutdown();
+
+			std::vector<std::string> expected { "journal:start_exception", "logic:start",
+				"journal:shutdown", "logic:shutdown" };
+			ASSERT_EQ(expected, trace);
+		}
+
+		TEST(aggregate_event_handler_test, should_be_driven_by_processor_through_static_type)
+		{
+			typedef ring_buffer<stub_event, 8, yielding_wait_strategy<>, producer_type::single> ring_buffer_type;
+			ring_buffer_type ring;
+			std::vector<std::string> trace;
+			tracing_handler journal("journal", trace);
+			tracing_handler logic("logic", trace);
+			aggregate_type aggregate(journal, logic);
+			batch_event_processor<ring_buffer_type, ring_buffer_type::sequence_barrier_type, aggregate_type> processor(
+				ring, ring.new_barrier(), aggregate);
+			ring.add_gating_sequences({ &processor.get_sequence() });
+
+			int64_t hi = ring.next(2);
+			ring[hi - 1].set_value(5);
+			ring[hi].set_value(6);
+			ring.publish(hi - 1, hi);
+			processor.start();
+			ASSERT_EQ(2, processor.process_available(8));
+			processor.shutdown();
+
+			std::vector<std::string> expected { "journal:start", "logic:start", "journal:5", "logic:5",
+				"journal:6!", "logic:6!", "journal:shutdown", "logic:shutdown" };
+			ASSERT_EQ(expected, trace);
+		}
+	}
+}
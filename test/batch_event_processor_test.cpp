@@ -0,0 +1,438 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+#include "support/stub_event_handler.h"
+#include "utils/count_down_latch.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		class recording_handler : public stub_event_handler<stub_event>
+		{
+		public:
+			explicit recording_handler(count_down_latch& latch)
+				: latch_(latch)
+			{
+			}
+
+			virtual void on_event(stub_event& event, int64_t sequence, bool end_of_batch)
+			{
+				values_.push_back(event.get_value());
+				latch_.count_down();
+			}
+
+			std::vector<int> values_;
+
+		private:
+			count_down_latch& latch_;
+		};
+
+		class recording_batch_handler : public batch_event_handler<stub_event>
+		{
+		public:
+			recording_batch_handler(count_down_latch& latch, int64_t failing_lo = -1)
+				: failed_sequence_(-1),
+				  failed_event_(nullptr),
+				  latch_(latch),
+				  failing_lo_(failing_lo)
+			{
+			}
+
+			virtual void on_start() { }
+			virtual void on_shutdown() { }
+
+			virtual void on_batch(strided_span<stub_event> first, strided_span<stub_event> second, int64_t lo)
+			{
+				segment_sizes_.push_back(first.size());
+				segment_sizes_.push_back(second.size());
+				if (lo == failing_lo_)
+					throw std::runtime_error("failed batch");
+				for (auto& event : first)
+					values_.push_back(event.get_value());
+				for (std::size_t i = 0; i < second.size(); i++)
+					values_.push_back(second[i].get_value());
+				for (std::size_t i = 0; i < first.size() + second.size(); i++)
+					latch_.count_down();
+			}
+
+			virtual void on_timeout(int64_t sequence) { }
+
+			virtual void on_event_exception(const std::exception& ex, int64_t sequence, stub_event* event)
+			{
+				failed_sequence_ = sequence;
+				failed_event_ = event;
+				latch_.count_down();
+			}
+
+			virtual void on_start_exception(const std::exception& ex) { }
+			virtual void on_shutdown_exception(const std::exception& ex) { }
+
+			std::vector<int> values_;
+			std::vector<std::size_t> segment_sizes_;
+			int64_t failed_sequence_;
+			stub_event* failed_event_;
+
+		private:
+			count_down_latch& latch_;
+			int64_t failing_lo_;
+		};
+
+		class failing_handler : public stub_event_handler<stub_event>
+		{
+		public:
+			explicit failing_handler(int failing_value)
+				: failing_value_(failing_value)
+			{
+			}
+
+			virtual void on_event(stub_event& event, int64_t sequence, bool end_of_batch)
+			{
+				if (event.get_value() == failing_value_)
+					throw std::runtime_error("failed event");
+				values_.push_back(event.get_value());
+			}
+
+			virtual void on_event_exception(const std::exception& ex, int64_t sequence, stub_event* event)
+			{
+				failed_sequences_.push_back(sequence);
+			}
+
+			std::vector<int> values_;
+			std::vector<int64_t> failed_sequences_;
+
+		private:
+			int failing_value_;
+		};
+
+		class noexcept_handler final
+		{
+		public:
+			void on_start() { }
+			void on_shutdown() { }
+			void on_event(stub_event& event, int64_t sequence, bool end_of_batch) noexcept { sum_ += event.get_value(); }
+			void on_timeout(int64_t sequence) { }
+			void on_event_exception(const std::exception& ex, int64_t sequence, stub_event* event) { }
+			void on_start_exception(const std::exception& ex) { }
+			void on_shutdown_exception(const std::exception& ex) { }
+
+			int sum_ = 0;
+		};
+
+		class batch_event_processor_test : public testing::Test
+		{
+		protected:
+			typedef ring_buffer<stub_event, 8, blocking_wait_strategy, producer_type::single> ring_buffer_type;
+
+			void publish(int count)
+			{
+				int64_t hi = ring_buffer_.next(count);
+				for (int64_t seq = hi - count + 1; seq <= hi; seq++)
+					ring_buffer_[seq].set_value((int)seq);
+				ring_buffer_.publish(hi - count + 1, hi);
+			}
+
+			template <typename TProcessor>
+			void wait_until_processed(TProcessor& processor, int64_t seq)
+			{
+				while (processor.get_sequence().get() < seq)
+					std::this_thread::yield();
+			}
+
+			template <typename TExceptionHandler>
+			using policy_processor_type = batch_event_processor<ring_buffer_type,
+				ring_buffer_type::sequence_barrier_type, event_handler<stub_event>, TExceptionHandler>;
+
+			ring_buffer_type ring_buffer_;
+		};
+
+		TEST_F(batch_event_processor_test, should_call_on_event_for_each_event)
+		{
+			count_down_latch latch(3);
+			recording_handler handler(latch);
+			batch_event_processor<ring_buffer_type> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+			std::thread t([&processor] { processor.run(); });
+
+			publish(3);
+			ASSERT_TRUE(latch.wait(std::chrono::seconds(5)));
+			processor.halt();
+			t.join();
+
+			ASSERT_EQ((std::vector<int> { 0, 1, 2 }), handler.values_);
+		}
+
+		TEST_F(batch_event_processor_test, should_split_batch_at_wrap)
+		{
+			count_down_latch latch(12);
+			recording_batch_handler handler(latch);
+			batch_event_processor<ring_buffer_type> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			// Each publish is a single range, so each is seen as a single batch.
+			publish(6);
+			std::thread t([&processor] { processor.run(); });
+			wait_until_processed(processor, 5);
+			publish(6);
+			ASSERT_TRUE(latch.wait(std::chrono::seconds(5)));
+			processor.halt();
+			t.join();
+
+			ASSERT_EQ((std::vector<int> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }), handler.values_);
+			ASSERT_EQ((std::vector<std::size_t> { 6, 0, 2, 4 }), handler.segment_sizes_);
+		}
+
+		TEST_F(batch_event_processor_test, should_expose_padded_slots_as_strided_segments)
+		{
+			publish(3);
+			auto segments = ring_buffer_.get_segments(0, 2);
+			ASSERT_EQ(3u, segments.first.size());
+			ASSERT_FALSE(segments.first.is_contiguous());
+			ASSERT_EQ(&ring_buffer_[1], &segments.first[1]);
+
+			stub_event events[2];
+			ASSERT_TRUE(strided_span<stub_event>(events, 2).is_contiguous());
+		}
+
+		TEST_F(batch_event_processor_test, should_report_failed_batch_and_continue)
+		{
+			count_down_latch latch(3);
+			recording_batch_handler handler(latch, 0);
+			batch_event_processor<ring_buffer_type> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(2);
+			std::thread t([&processor] { processor.run(); });
+			wait_until_processed(processor, 1);
+			publish(2);
+			ASSERT_TRUE(latch.wait(std::chrono::seconds(5)));
+			processor.halt();
+			t.join();
+
+			ASSERT_EQ(0, handler.failed_sequence_);
+			ASSERT_EQ(nullptr, handler.failed_event_);
+			ASSERT_EQ((std::vector<int> { 2, 3 }), handler.values_);
+		}
+
+		TEST_F(batch_event_processor_test, should_process_available_events_without_waiting)
+		{
+			count_down_latch latch(5);
+			recording_handler handler(latch);
+			batch_event_processor<ring_buffer_type> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			processor.start();
+			ASSERT_TRUE(processor.is_running());
+			ASSERT_EQ(0, processor.process_available(4));
+
+			publish(5);
+			ASSERT_EQ(4, processor.process_available(4));
+			ASSERT_EQ(3, processor.get_sequence().get());
+			ASSERT_EQ(1, processor.process_available(4));
+			ASSERT_EQ(0, processor.process_available(4));
+			processor.shutdown();
+
+			ASSERT_FALSE(processor.is_running());
+			ASSERT_EQ(4, processor.get_sequence().get());
+			ASSERT_EQ((std::vector<int> { 0, 1, 2, 3, 4 }), handler.values_);
+			ASSERT_THROW(processor.process_available(0), std::invalid_argument);
+		}
+
+		TEST_F(batch_event_processor_test, should_process_available_batch_and_skip_failed_batch)
+		{
+			count_down_latch latch(4);
+			recording_batch_handler handler(latch, 0);
+			batch_event_processor<ring_buffer_type> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(3);
+			ASSERT_EQ(2, processor.process_available(2));
+			ASSERT_EQ(0, handler.failed_sequence_);
+			ASSERT_EQ(1, processor.process_available(2));
+
+			ASSERT_EQ((std::vector<int> { 2 }), handler.values_);
+			ASSERT_EQ(2, processor.get_sequence().get());
+		}
+
+		TEST_F(batch_event_processor_test, should_process_with_batch_event_handler_type)
+		{
+			count_down_latch latch(3);
+			recording_batch_handler handler(latch);
+			batch_event_processor<ring_buffer_type, ring_buffer_type::sequence_barrier_type,
+				batch_event_handler<stub_event>> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			batch_event_processor<ring_buffer_type, ring_buffer_type::sequence_barrier_type,
+				recording_batch_handler> static_processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(3);
+			ASSERT_EQ(3, processor.process_available(8));
+			ASSERT_EQ((std::vector<int> { 0, 1, 2 }), handler.values_);
+			ASSERT_EQ((std::vector<std::size_t> { 3, 0 }), handler.segment_sizes_);
+		}
+
+		TEST_F(batch_event_processor_test, should_process_behind_static_dependency)
+		{
+			count_down_latch first_latch(3);
+			count_down_latch second_latch(3);
+			recording_handler first_handler(first_latch);
+			recording_handler second_handler(second_latch);
+			batch_event_processor<ring_buffer_type> first(ring_buffer_, ring_buffer_.new_barrier(), first_handler);
+			batch_event_processor<ring_buffer_type, ring_buffer_type::static_sequence_barrier_type<1>> second(
+				ring_buffer_, ring_buffer_.new_barrier(std::array<sequence*, 1> { { &first.get_sequence() } }), second_handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &second.get_sequence() });
+
+			publish(3);
+			ASSERT_EQ(0, second.process_available(8));
+			ASSERT_EQ(2, first.process_available(2));
+			ASSERT_EQ(2, second.process_available(8));
+			ASSERT_EQ(1, first.process_available(2));
+			ASSERT_EQ(1, second.process_available(8));
+			ASSERT_EQ((std::vector<int> { 0, 1, 2 }), second_handler.values_);
+		}
+
+		TEST_F(batch_event_processor_test, should_resume_after_failing_event_within_batch)
+		{
+			failing_handler handler(1);
+			batch_event_processor<ring_buffer_type> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(3);
+			ASSERT_EQ(3, processor.process_available(8));
+			ASSERT_EQ((std::vector<int> { 0, 2 }), handler.values_);
+			ASSERT_EQ((std::vector<int64_t> { 1 }), handler.failed_sequences_);
+			ASSERT_EQ(2, processor.get_sequence().get());
+		}
+
+		TEST_F(batch_event_processor_test, should_halt_on_failing_event_with_halting_policy)
+		{
+			failing_handler handler(1);
+			policy_processor_type<halting_exception_handler> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(3);
+			processor.start();
+			ASSERT_EQ(1, processor.process_available(8));
+			ASSERT_FALSE(processor.is_running());
+			ASSERT_EQ(0, processor.get_sequence().get());
+			ASSERT_EQ((std::vector<int64_t> { 1 }), handler.failed_sequences_);
+			// A halted processor processes nothing until it is started again.
+			ASSERT_EQ(0, processor.process_available(8));
+			ASSERT_EQ((std::vector<int64_t> { 1 }), handler.failed_sequences_);
+			processor.shutdown();
+
+			// A restarted processor retries the failing event.
+			processor.start();
+			ASSERT_EQ(0, processor.process_available(8));
+			ASSERT_EQ(0, processor.get_sequence().get());
+			ASSERT_EQ((std::vector<int64_t> { 1, 1 }), handler.failed_sequences_);
+			processor.shutdown();
+		}
+
+		TEST_F(batch_event_processor_test, should_leave_failed_batch_unprocessed_with_halting_policy)
+		{
+			count_down_latch latch(1);
+			recording_batch_handler handler(latch, 0);
+			policy_processor_type<halting_exception_handler> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(3);
+			processor.start();
+			ASSERT_EQ(0, processor.process_available(8));
+			ASSERT_FALSE(processor.is_running());
+			ASSERT_EQ(-1, processor.get_sequence().get());
+			ASSERT_EQ(0, handler.failed_sequence_);
+			processor.shutdown();
+		}
+
+		TEST_F(batch_event_processor_test, should_stop_run_on_failing_event_with_halting_policy)
+		{
+			failing_handler handler(1);
+			policy_processor_type<halting_exception_handler> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(3);
+			std::thread t([&processor] { processor.run(); });
+			t.join();
+
+			ASSERT_FALSE(processor.is_running());
+			ASSERT_EQ(0, processor.get_sequence().get());
+			ASSERT_EQ((std::vector<int> { 0 }), handler.values_);
+		}
+
+		TEST_F(batch_event_processor_test, should_rethrow_with_fatal_policy)
+		{
+			failing_handler handler(1);
+			policy_processor_type<fatal_exception_handler> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(3);
+			ASSERT_THROW(processor.run(), std::runtime_error);
+			ASSERT_FALSE(processor.is_running());
+			ASSERT_EQ(0, processor.get_sequence().get());
+			ASSERT_TRUE(handler.failed_sequences_.empty());
+		}
+
+		TEST_F(batch_event_processor_test, should_drop_exceptions_with_ignore_policy)
+		{
+			failing_handler handler(0);
+			policy_processor_type<ignore_exception_handler> processor(ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(2);
+			ASSERT_EQ(2, processor.process_available(8));
+			ASSERT_EQ((std::vector<int> { 1 }), handler.values_);
+			ASSERT_TRUE(handler.failed_sequences_.empty());
+		}
+
+		TEST_F(batch_event_processor_test, should_process_with_noexcept_handler)
+		{
+			noexcept_handler handler;
+			batch_event_processor<ring_buffer_type, ring_buffer_type::sequence_barrier_type, noexcept_handler> processor(
+				ring_buffer_, ring_buffer_.new_barrier(), handler);
+			ring_buffer_.add_gating_sequences(std::vector<sequence*> { &processor.get_sequence() });
+
+			publish(4);
+			ASSERT_EQ(4, processor.process_available(8));
+			ASSERT_EQ(6, handler.sum_);
+		}
+	}
+}
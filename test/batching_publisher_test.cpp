@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		class batching_publisher_test : public testing::Test
+		{
+		protected:
+			typedef ring_buffer<stub_event, 16, busy_spin_wait_strategy, producer_type::multi> ring_buffer_type;
+
+			batching_publisher_test()
+			{
+				ring_buffer_.add_gating_sequences({ &consumer_sequence_ });
+			}
+
+			ring_buffer_type ring_buffer_;
+			sequence consumer_sequence_;
+		};
+
+		TEST_F(batching_publisher_test, should_publish_when_batch_is_full)
+		{
+			batching_publisher<ring_buffer_type, 4> publisher(ring_buffer_);
+			for (int i = 0; i < 3; i++)
+				publisher.publish(stub_event(i));
+			ASSERT_EQ(-1, ring_buffer_.get_cursor());
+			ASSERT_EQ(3u, publisher.size());
+
+			publisher.publish_event([](stub_event& event) { event.set_value(3); });
+			ASSERT_EQ(3, ring_buffer_.get_cursor());
+			ASSERT_EQ(0u, publisher.size());
+			for (int i = 0; i < 4; i++)
+			{
+				ASSERT_TRUE(ring_buffer_.is_available(i));
+				ASSERT_EQ(i, ring_buffer_[i].get_value());
+			}
+		}
+
+		TEST_F(batching_publisher_test, should_publish_partial_batch_on_flush)
+		{
+			batching_publisher<ring_buffer_type, 4> publisher(ring_buffer_);
+			publisher.flush();
+			ASSERT_EQ(-1, ring_buffer_.get_cursor());
+
+			publisher.publish(stub_event(7));
+			publisher.publish(stub_event(8));
+			publisher.flush();
+			ASSERT_EQ(1, ring_buffer_.get_cursor());
+			ASSERT_EQ(8, ring_buffer_[1].get_value());
+			ASSERT_TRUE(ring_buffer_.is_available(1));
+		}
+
+		TEST_F(batching_publisher_test, should_flush_on_destruction)
+		{
+			{
+				batching_publisher<ring_buffer_type, 4> publisher(ring_buffer_);
+				publisher.publish(stub_event(1));
+			}
+			ASSERT_EQ(0, ring_buffer_.get_cursor());
+			ASSERT_TRUE(ring_buffer_.is_available(0));
+		}
+
+		TEST_F(batching_publisher_test, should_flush_when_oldest_event_exceeds_delay)
+		{
+			batching_publisher<ring_buffer_type, 8> publisher(ring_buffer_, std::chrono::milliseconds(1));
+			publisher.publish(stub_event(1));
+			ASSERT_EQ(-1, ring_buffer_.get_cursor());
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			publisher.publish(stub_event(2));
+			ASSERT_EQ(1, ring_buffer_.get_cursor());
+			ASSERT_EQ(0u, publisher.size());
+		}
+	}
+}
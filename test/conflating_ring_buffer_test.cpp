@@ -0,0 +1,139 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		class conflating_ring_buffer_test : public testing::Test
+		{
+		protected:
+			typedef conflating_ring_buffer<int64_t, 8, yielding_wait_strategy<>, producer_type::multi> conflating_type;
+
+			std::map<std::size_t, int64_t> poll()
+			{
+				std::map<std::size_t, int64_t> values;
+				buffer_.poll([&values](std::size_t key, const int64_t& value)
+				{
+					EXPECT_EQ(0u, values.count(key));
+					values[key] = value;
+				});
+				return values;
+			}
+
+			conflating_type buffer_;
+		};
+
+		TEST_F(conflating_ring_buffer_test, should_deliver_latest_value_once_per_key)
+		{
+			buffer_.publish(1, 10);
+			buffer_.publish(2, 20);
+			buffer_.publish(1, 11);
+			buffer_.publish(1, 12);
+			ASSERT_EQ(1, buffer_.get_ring_buffer().get_cursor());
+
+			auto values = poll();
+			ASSERT_EQ(2u, values.size());
+			ASSERT_EQ(12, values[1]);
+			ASSERT_EQ(20, values[2]);
+			ASSERT_TRUE(poll().empty());
+		}
+
+		TEST_F(conflating_ring_buffer_test, should_republish_key_after_it_is_taken)
+		{
+			buffer_.publish(3, 1);
+			ASSERT_EQ(1u, poll().size());
+			buffer_.publish(3, 2);
+			auto values = poll();
+			ASSERT_EQ(1u, values.size());
+			ASSERT_EQ(2, values[3]);
+		}
+
+		TEST_F(conflating_ring_buffer_test, should_reject_key_out_of_range)
+		{
+			ASSERT_THROW(buffer_.publish(8, 0), std::out_of_range);
+		}
+
+		TEST_F(conflating_ring_buffer_test, should_throw_alert_exception_when_alerted)
+		{
+			buffer_.alert();
+			ASSERT_THROW(buffer_.wait_and_poll([](std::size_t, const int64_t&) { }), alert_exception);
+			buffer_.clear_alert();
+			buffer_.publish(0, 5);
+			ASSERT_EQ(1, buffer_.wait_and_poll([](std::size_t, const int64_t&) { }));
+		}
+
+		TEST_F(conflating_ring_buffer_test, should_never_go_back_in_time_under_concurrent_updates)
+		{
+			static constexpr int64_t UPDATES = 20000;
+			std::vector<std::thread> producers;
+			for (std::size_t key = 0; key < 8; key += 2)
+			{
+				producers.emplace_back([this, key]
+				{
+					for (int64_t i = 1; i <= UPDATES; i++)
+					{
+						buffer_.publish(key, i);
+						buffer_.publish(key + 1, i);
+					}
+				});
+			}
+
+			int64_t latest[8] = {};
+			bool in_order = true;
+			int64_t done = 0;
+			while (done < 8)
+			{
+				done = 0;
+				buffer_.poll([&](std::size_t key, const int64_t& value)
+				{
+					in_order = in_order && value > latest[key];
+					latest[key] = value;
+				});
+				for (int64_t value : latest)
+					done += value == UPDATES ? 1 : 0;
+				std::this_thread::yield();
+			}
+			for (auto& producer : producers)
+				producer.join();
+			ASSERT_TRUE(in_order);
+		}
+	}
+}
@@ -0,0 +1,287 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <disruptor4cpp/disruptor4cpp.h>
+
+#ifdef DISRUPTOR4CPP_HAS_COROUTINES
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "support/stub_event.h"
+#include "utils/count_down_latch.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			struct coroutine_test_tag
+			{
+			};
+
+			typedef shared_wait_strategy<blocking_wait_strategy, coroutine_test_tag> test_wait_strategy;
+			typedef ring_buffer<stub_event, 8, test_wait_strategy, producer_type::single> ring_buffer_type;
+			typedef coroutine_scheduler<test_wait_strategy> scheduler_type;
+
+			struct session
+			{
+				session()
+					: sequence_barrier(ring.new_barrier()),
+					  latch(nullptr),
+					  alerted(false)
+				{
+					ring.add_gating_sequences({ &consumer_sequence });
+				}
+
+				ring_buffer_type ring;
+				std::unique_ptr<ring_buffer_type::sequence_barrier_type> sequence_barrier;
+				sequence consumer_sequence;
+				std::vector<int> received;
+				count_down_latch* latch;
+				bool alerted;
+			};
+
+			consumer_task consume(scheduler_type& scheduler, session& s)
+			{
+				int64_t next_sequence = s.consumer_sequence.get() + 1;
+				try
+				{
+					while (true)
+					{
+						int64_t available_sequence = co_await scheduler.next_batch(*s.sequence_barrier, next_sequence);
+						for (; next_sequence <= available_sequence; next_sequence++)
+						{
+							s.received.push_back(s.ring[next_sequence].get_value());
+							if (s.latch != nullptr)
+								s.latch->count_down();
+						}
+						s.consumer_sequence.set(available_sequence);
+					}
+				}
+				catch (alert_exception&)
+				{
+					s.alerted = true;
+				}
+			}
+
+			template <typename TScheduler>
+			consumer_task produce(TScheduler& scheduler, ring_buffer_type& ring, int count, int batch_size)
+			{
+				for (int value = 0; value < count; value += batch_size)
+				{
+					int64_t hi = co_await scheduler.async_next(ring, batch_size);
+					int64_t lo = hi - batch_size + 1;
+					for (int64_t seq = lo; seq <= hi; seq++)
+						ring[seq].set_value(value + static_cast<int>(seq - lo));
+					ring.publish(lo, hi);
+				}
+			}
+
+			struct counting_idle_strategy
+			{
+				void idle(int work_count)
+				{
+					idle_count++;
+					std::this_thread::yield();
+				}
+
+				void reset()
+				{
+				}
+
+				static std::atomic<int> idle_count;
+			};
+
+			std::atomic<int> counting_idle_strategy::idle_count(0);
+
+			void publish(ring_buffer_type& ring, int value)
+			{
+				int64_t seq = ring.next();
+				ring[seq].set_value(value);
+				ring.publish(seq);
+			}
+		}
+
+		TEST(coroutine_scheduler_test, should_resume_only_consumers_with_published_events)
+		{
+			scheduler_type scheduler;
+			std::vector<std::unique_ptr<session>> sessions;
+			for (int i = 0; i < 64; i++)
+			{
+				sessions.emplace_back(new session());
+				scheduler.spawn(consume(scheduler, *sessions.back()));
+			}
+
+			ASSERT_TRUE(scheduler.run_once());
+			ASSERT_EQ(64u, scheduler.get_waiting_count());
+			ASSERT_FALSE(scheduler.run_once());
+
+			publish(sessions[3]->ring, 7);
+			publish(sessions[3]->ring, 8);
+			ASSERT_TRUE(scheduler.run_once());
+			ASSERT_EQ(64u, scheduler.get_waiting_count());
+			ASSERT_EQ((std::vector<int> { 7, 8 }), sessions[3]->received);
+			ASSERT_EQ(1, sessions[3]->consumer_sequence.get());
+			for (int i = 0; i < 64; i++)
+			{
+				if (i != 3)
+				{
+					ASSERT_TRUE(sessions[i]->received.empty());
+				}
+			}
+		}
+
+		TEST(coroutine_scheduler_test, should_finish_consumer_on_alert)
+		{
+			scheduler_type scheduler;
+			session s;
+			scheduler.spawn(consume(scheduler, s));
+			scheduler.run_once();
+			ASSERT_EQ(1u, scheduler.get_waiting_count());
+
+			s.sequence_barrier->alert();
+			ASSERT_TRUE(scheduler.run_once());
+			ASSERT_TRUE(s.alerted);
+			ASSERT_EQ(0u, scheduler.get_waiting_count());
+		}
+
+		TEST(coroutine_scheduler_test, should_suspend_producer_until_capacity_is_freed)
+		{
+			scheduler_type scheduler;
+			session s;
+			scheduler.spawn(produce(scheduler, s.ring, 6, 2));
+			scheduler.spawn(produce(scheduler, s.ring, 6, 2));
+
+			ASSERT_TRUE(scheduler.run_once());
+			ASSERT_EQ(1u, scheduler.get_waiting_count());
+			ASSERT_EQ(7, s.ring.get_cursor());
+
+			s.consumer_sequence.set(1);
+			ASSERT_TRUE(scheduler.run_once());
+			ASSERT_EQ(9, s.ring.get_cursor());
+			ASSERT_FALSE(scheduler.run_once());
+
+			s.consumer_sequence.set(9);
+			ASSERT_TRUE(scheduler.run_once());
+			ASSERT_EQ(0u, scheduler.get_waiting_count());
+			ASSERT_EQ(11, s.ring.get_cursor());
+		}
+
+		TEST(coroutine_scheduler_test, should_idle_through_idle_strategy_while_producer_waits)
+		{
+			coroutine_scheduler<test_wait_strategy, counting_idle_strategy> scheduler;
+			session s;
+			scheduler.spawn(produce(scheduler, s.ring, 10, 1));
+
+			std::thread scheduler_thread([&scheduler] { scheduler.run(); });
+			while (counting_idle_strategy::idle_count.load() == 0)
+				std::this_thread::yield();
+			s.consumer_sequence.set(1);
+			while (s.ring.get_cursor() != 9)
+				std::this_thread::yield();
+			scheduler.stop();
+			scheduler_thread.join();
+
+			ASSERT_EQ(0u, scheduler.get_waiting_count());
+		}
+
+		TEST(coroutine_scheduler_test, should_reject_invalid_claim_size)
+		{
+			scheduler_type scheduler;
+			ring_buffer_type ring;
+			ASSERT_THROW(scheduler.async_next(ring, 0), std::invalid_argument);
+			ASSERT_THROW(scheduler.async_next(ring, 9), std::invalid_argument);
+		}
+
+		TEST(coroutine_scheduler_test, should_pass_events_between_coroutines_on_full_ring)
+		{
+			scheduler_type scheduler;
+			session s;
+			count_down_latch latch(100);
+			s.latch = &latch;
+			scheduler.spawn(produce(scheduler, s.ring, 100, 4));
+			scheduler.spawn(consume(scheduler, s));
+
+			std::thread scheduler_thread([&scheduler] { scheduler.run(); });
+			latch.wait();
+			scheduler.stop();
+			scheduler_thread.join();
+
+			ASSERT_EQ(100u, s.received.size());
+			for (int i = 0; i < 100; i++)
+				ASSERT_EQ(i, s.received[i]);
+		}
+
+		TEST(coroutine_scheduler_test, should_return_from_run_when_stopped_before_start)
+		{
+			scheduler_type scheduler;
+			session s;
+			scheduler.spawn(consume(scheduler, s));
+			scheduler.stop();
+			scheduler.run();
+			ASSERT_FALSE(scheduler.is_running());
+			ASSERT_FALSE(scheduler.is_alerted());
+		}
+
+		TEST(coroutine_scheduler_test, should_wake_up_on_publish)
+		{
+			scheduler_type scheduler;
+			session first;
+			session second;
+			count_down_latch latch(3);
+			first.latch = &latch;
+			second.latch = &latch;
+			scheduler.spawn(consume(scheduler, first));
+			scheduler.spawn(consume(scheduler, second));
+
+			std::thread scheduler_thread([&scheduler] { scheduler.run(); });
+			publish(first.ring, 1);
+			publish(second.ring, 2);
+			publish(first.ring, 3);
+			latch.wait();
+			scheduler.stop();
+			scheduler_thread.join();
+
+			ASSERT_EQ((std::vector<int> { 1, 3 }), first.received);
+			ASSERT_EQ((std::vector<int> { 2 }), second.received);
+		}
+	}
+}
+
+#endif
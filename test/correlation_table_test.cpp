@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+#include "support/stub_event_handler.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			typedef correlation_table<int, 8> table_type;
+
+			struct response_event
+			{
+				int64_t request_sequence;
+				int value;
+			};
+
+			typedef ring_buffer<stub_event, 8, yielding_wait_strategy<>, producer_type::single> request_ring_type;
+			typedef ring_buffer<response_event, 8, yielding_wait_strategy<>, producer_type::single> response_ring_type;
+
+			template <typename TEvent>
+			class function_handler : public stub_event_handler<TEvent>
+			{
+			public:
+				template <typename TFunction>
+				explicit function_handler(TFunction function)
+					: function_(function)
+				{
+				}
+
+				virtual void on_event(TEvent& event, int64_t sequence, bool end_of_batch)
+				{
+					function_(event, sequence);
+				}
+
+			private:
+				std::function<void(TEvent&, int64_t)> function_;
+			};
+
+			void record_response(void* context, int64_t sequence, int& response)
+			{
+				static_cast<std::vector<std::pair<int64_t, int>>*>(context)->push_back(std::make_pair(sequence, response));
+			}
+		}
+
+		TEST(correlation_table_test, should_complete_by_sequence)
+		{
+			table_type table;
+			ASSERT_FALSE(table.is_complete(3));
+
+			table.complete(3, 30);
+			ASSERT_TRUE(table.is_complete(3));
+			ASSERT_FALSE(table.is_complete(2));
+			ASSERT_EQ(30, table.get_response(3));
+			ASSERT_EQ(30, table.wait(3));
+		}
+
+		TEST(correlation_table_test, should_not_report_previous_lap_as_complete)
+		{
+			table_type table;
+			table.complete(1, 10);
+			ASSERT_TRUE(table.is_complete(1));
+			ASSERT_FALSE(table.is_complete(9));
+
+			table.complete(9, 90);
+			ASSERT_TRUE(table.is_complete(9));
+			ASSERT_FALSE(table.is_complete(1));
+			ASSERT_EQ(90, table.get_response(9));
+		}
+
+		TEST(correlation_table_test, should_invoke_registered_callback)
+		{
+			table_type table;
+			std::vector<std::pair<int64_t, int>> received;
+			table.on_complete(4, &record_response, &received);
+
+			table.complete(4, 40);
+			table.complete(5, 50);
+			std::vector<std::pair<int64_t, int>> expected { { 4, 40 } };
+			ASSERT_EQ(expected, received);
+			ASSERT_FALSE(table.is_complete(4));
+			ASSERT_TRUE(table.is_complete(5));
+
+			table.complete(12, 120);
+			ASSERT_EQ(1u, received.size());
+			ASSERT_TRUE(table.is_complete(12));
+		}
+
+		TEST(correlation_table_test, should_correlate_over_paired_rings)
+		{
+			request_ring_type request_ring;
+			response_ring_type response_ring;
+			table_type table;
+
+			function_handler<stub_event> responder([&response_ring](stub_event& event, int64_t sequence)
+			{
+				int64_t seq = response_ring.next();
+				response_ring[seq].request_sequence = sequence;
+				response_ring[seq].value = event.get_value() * 2;
+				response_ring.publish(seq);
+			});
+			function_handler<response_event> completer([&table](response_event& event, int64_t sequence)
+			{
+				table.complete(event.request_sequence, event.value);
+			});
+			batch_event_processor<request_ring_type> responder_processor(request_ring, request_ring.new_barrier(), responder);
+			batch_event_processor<response_ring_type> completer_processor(response_ring, response_ring.new_barrier(), completer);
+			request_ring.add_gating_sequences({ &responder_processor.get_sequence() });
+			response_ring.add_gating_sequences({ &completer_processor.get_sequence() });
+
+			std::thread responder_thread([&responder_processor] { responder_processor.run(); });
+			std::thread completer_thread([&completer_processor] { completer_processor.run(); });
+			for (int i = 0; i < 100; i++)
+			{
+				int64_t seq = request_ring.next();
+				request_ring[seq].set_value(i);
+				request_ring.publish(seq);
+				ASSERT_EQ(i * 2, table.wait(seq));
+			}
+			responder_processor.halt();
+			completer_processor.halt();
+			responder_thread.join();
+			completer_thread.join();
+		}
+	}
+}
@@ -0,0 +1,66 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/utils/crc32c.h>
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		TEST(crc32c_test, should_match_check_value)
+		{
+			ASSERT_EQ(0xe3069283u, crc32c::compute("123456789", 9));
+			ASSERT_EQ(0u, crc32c::compute("", 0));
+		}
+
+		TEST(crc32c_test, should_match_software_implementation)
+		{
+			uint8_t data[100];
+			for (int i = 0; i < 100; i++)
+				data[i] = static_cast<uint8_t>(i * 7 + 3);
+			for (std::size_t length = 0; length <= sizeof(data); length += 13)
+			{
+				ASSERT_EQ(~crc32c::update_software(~0u, data, length), crc32c::compute(data, length));
+			}
+		}
+
+		TEST(crc32c_test, should_continue_checksum)
+		{
+			const char* text = "disruptor4cpp journal";
+			const std::size_t length = std::strlen(text);
+			ASSERT_EQ(crc32c::compute(text, length), crc32c::update(crc32c::compute(text, 5), text + 5, length - 5));
+		}
+	}
+}
@@ -28,6 +28,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <array>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -50,5 +51,30 @@ namespace disruptor4cpp
 			sequence1.set(48);
 			ASSERT_EQ(47, group.get());
 		}
+
+		TEST(fixed_sequence_group_test, should_return_minimum_of_static_group)
+		{
+			sequence sequence1(34);
+			sequence sequence2(47);
+			sequence sequence3(40);
+			auto group = static_sequence_group<sequence, 3>::create(
+				std::array<sequence*, 3> { { &sequence1, &sequence2, &sequence3 } });
+
+			ASSERT_EQ(34, group.get());
+			sequence1.set(45);
+			ASSERT_EQ(40, group.get());
+			sequence3.set(48);
+			ASSERT_EQ(45, group.get());
+		}
+
+		TEST(fixed_sequence_group_test, should_return_single_sequence_of_static_group)
+		{
+			sequence sequence1(3);
+			auto group = static_sequence_group<sequence, 1>::create(std::array<sequence*, 1> { { &sequence1 } });
+
+			ASSERT_EQ(3, group.get());
+			sequence1.set(4);
+			ASSERT_EQ(4, group.get());
+		}
 	}
 }
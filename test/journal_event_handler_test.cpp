@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "utils/temp_directory.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			struct journaled_event
+			{
+				int64_t value;
+				int32_t kind;
+				int32_t reserved;
+			};
+
+			typedef journal_event_handler<journaled_event> test_journal_handler;
+
+			struct empty_event_serializer
+			{
+				static std::size_t size(const journaled_event&)
+				{
+					return 0;
+				}
+
+				static void write(const journaled_event&, uint8_t*)
+				{
+				}
+
+				static void read(const uint8_t*, std::size_t, journaled_event&)
+				{
+				}
+			};
+
+			std::vector<journal_record_header> read_records(const std::string& path)
+			{
+				mapped_file segment = mapped_file::open_read_only(path);
+				journal_segment_header header;
+				std::memcpy(&header, segment.get_data(), sizeof(header));
+				EXPECT_EQ(static_cast<uint64_t>(journal_format::MAGIC), header.magic);
+				EXPECT_EQ(static_cast<uint32_t>(journal_format::VERSION), header.version);
+
+				std::vector<journal_record_header> records;
+				std::size_t offset = journal_format::SEGMENT_HEADER_LENGTH;
+				while (offset + journal_format::RECORD_HEADER_LENGTH <= segment.get_size())
+				{
+					journal_record_header record;
+					std::memcpy(&record, segment.get_data() + offset, sizeof(record));
+					if (record.length == 0)
+						break;
+					const uint8_t* payload = segment.get_data() + offset + journal_format::RECORD_HEADER_LENGTH;
+					EXPECT_EQ(journal_format::checksum(record.sequence, payload, record.length), record.checksum);
+					records.push_back(record);
+					offset += journal_format::record_length(record.length);
+				}
+				return records;
+			}
+		}
+
+		TEST(journal_event_handler_test, should_sync_once_per_batch)
+		{
+			temp_directory dir;
+			test_journal_handler handler(dir.get_path(), 4096);
+			journaled_event event = { 1, 2, 0 };
+			handler.on_event(event, 0, false);
+			handler.on_event(event, 1, false);
+			ASSERT_EQ(0u, handler.get_sync_count());
+			handler.on_event(event, 2, true);
+			ASSERT_EQ(1u, handler.get_sync_count());
+			handler.on_event(event, 3, true);
+			ASSERT_EQ(2u, handler.get_sync_count());
+			handler.on_shutdown();
+			ASSERT_EQ(2u, handler.get_sync_count());
+
+			auto records = read_records(journal_format::segment_path(dir.get_path(), 0));
+			ASSERT_EQ(4u, records.size());
+			for (int64_t i = 0; i < 4; i++)
+			{
+				ASSERT_EQ(i, records[i].sequence);
+				ASSERT_EQ(sizeof(journaled_event), records[i].length);
+			}
+		}
+
+		TEST(journal_event_handler_test, should_roll_segment_when_full)
+		{
+			temp_directory dir;
+			const std::size_t record_length = journal_format::record_length(sizeof(journaled_event));
+			test_journal_handler handler(dir.get_path(), journal_format::SEGMENT_HEADER_LENGTH + 2 * record_length);
+			journaled_event event = {};
+			for (int64_t i = 0; i < 5; i++)
+				handler.on_event(event, i, true);
+			ASSERT_EQ(2u, handler.get_segment_index());
+
+			auto segments = journal_format::list_segments(dir.get_path());
+			ASSERT_EQ(3u, segments.size());
+			ASSERT_EQ(2u, read_records(segments[0].second).size());
+			ASSERT_EQ(2u, read_records(segments[1].second).size());
+			auto last = read_records(segments[2].second);
+			ASSERT_EQ(1u, last.size());
+			ASSERT_EQ(4, last[0].sequence);
+		}
+
+		TEST(journal_event_handler_test, should_reject_empty_payload)
+		{
+			temp_directory dir;
+			journal_event_handler<journaled_event, empty_event_serializer> handler(dir.get_path(), 4096);
+			journaled_event event = {};
+			ASSERT_THROW(handler.on_event(event, 0, true), std::invalid_argument);
+			ASSERT_EQ(0u, read_records(journal_format::segment_path(dir.get_path(), 0)).size());
+		}
+
+		TEST(journal_event_handler_test, should_start_after_existing_segments)
+		{
+			temp_directory dir;
+			{
+				test_journal_handler handler(dir.get_path(), 4096);
+			}
+			test_journal_handler handler(dir.get_path(), 4096);
+			ASSERT_EQ(1u, handler.get_segment_index());
+		}
+
+		TEST(journal_event_handler_test, should_journal_events_from_processor)
+		{
+			typedef ring_buffer<journaled_event, 16, busy_spin_wait_strategy, producer_type::single> ring_buffer_type;
+			temp_directory dir;
+			ring_buffer_type ring;
+			test_journal_handler handler(dir.get_path(), 4096);
+			batch_event_processor<ring_buffer_type> processor(ring, ring.new_barrier(), handler);
+			ring.add_gating_sequences({ &processor.get_sequence() });
+
+			int64_t hi = ring.next(10);
+			for (int64_t seq = hi - 9; seq <= hi; seq++)
+				ring[seq].value = seq;
+			ring.publish(hi - 9, hi);
+
+			std::thread processor_thread([&processor] { processor.run(); });
+			while (processor.get_sequence().get() < hi)
+				std::this_thread::yield();
+			processor.halt();
+			processor_thread.join();
+
+			ASSERT_EQ(1u, handler.get_sync_count());
+			ASSERT_EQ(10u, read_records(journal_format::segment_path(dir.get_path(), 0)).size());
+		}
+	}
+}
@@ -0,0 +1,178 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event_handler.h"
+#include "utils/temp_directory.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			struct replayed_event
+			{
+				int64_t value;
+			};
+
+			class collecting_handler : public stub_event_handler<replayed_event>
+			{
+			public:
+				virtual void on_event(replayed_event& event, int64_t sequence, bool end_of_batch)
+				{
+					values_.push_back(event.value);
+					sequences_.push_back(sequence);
+				}
+
+				std::vector<int64_t> values_;
+				std::vector<int64_t> sequences_;
+			};
+
+			typedef ring_buffer<replayed_event, 4, yielding_wait_strategy<>, producer_type::single> ring_buffer_type;
+
+			void write_journal(const std::string& directory, int64_t count, std::size_t segment_size)
+			{
+				journal_event_handler<replayed_event> journaler(directory, segment_size);
+				for (int64_t seq = 0; seq < count; seq++)
+				{
+					replayed_event event = { seq * 100 };
+					journaler.on_event(event, seq, seq % 3 == 2);
+				}
+				journaler.on_shutdown();
+			}
+		}
+
+		TEST(journal_replayer_test, should_replay_journal_and_position_replayed_sequences)
+		{
+			temp_directory dir;
+			const std::size_t record_length = journal_format::record_length(sizeof(replayed_event));
+			write_journal(dir.get_path(), 10, journal_format::SEGMENT_HEADER_LENGTH + 4 * record_length);
+
+			ring_buffer_type ring;
+			collecting_handler handler;
+			batch_event_processor<ring_buffer_type> processor(ring, ring.new_barrier(), handler);
+			sequence journal_sequence;
+			ring.add_gating_sequences({ &processor.get_sequence(), &journal_sequence });
+			std::thread processor_thread([&processor] { processor.run(); });
+
+			journal_replayer<replayed_event> replayer(dir.get_path());
+			ASSERT_EQ(10, replayer.replay(ring, { &journal_sequence }, 3));
+			ASSERT_EQ(9, replayer.get_last_journal_sequence());
+			ASSERT_EQ(9, journal_sequence.get());
+
+			while (processor.get_sequence().get() < 9)
+				std::this_thread::yield();
+			processor.halt();
+			processor_thread.join();
+
+			ASSERT_EQ(10u, handler.values_.size());
+			for (int64_t i = 0; i < 10; i++)
+			{
+				ASSERT_EQ(i * 100, handler.values_[i]);
+				ASSERT_EQ(i, handler.sequences_[i]);
+			}
+			ASSERT_EQ(10, ring.next());
+		}
+
+		TEST(journal_replayer_test, should_replay_journal_with_restarted_sequences)
+		{
+			temp_directory dir;
+			write_journal(dir.get_path(), 3, 4096);
+			write_journal(dir.get_path(), 2, 4096);
+
+			ring_buffer_type ring;
+			sequence consumer_sequence;
+			ring.add_gating_sequences({ &consumer_sequence });
+			journal_replayer<replayed_event> replayer(dir.get_path());
+			ASSERT_EQ(5, replayer.replay(ring, { &consumer_sequence }));
+			ASSERT_EQ(1, replayer.get_last_journal_sequence());
+			ASSERT_EQ(100, ring[4].value);
+		}
+
+		TEST(journal_replayer_test, should_replay_only_records_appended_since_last_replay)
+		{
+			temp_directory dir;
+			write_journal(dir.get_path(), 3, 4096);
+
+			ring_buffer_type ring;
+			sequence consumer_sequence;
+			ring.add_gating_sequences({ &consumer_sequence });
+			journal_replayer<replayed_event> replayer(dir.get_path());
+			ASSERT_EQ(3, replayer.replay(ring, { &consumer_sequence }));
+			ASSERT_EQ(0, replayer.replay(ring, { &consumer_sequence }));
+
+			write_journal(dir.get_path(), 1, 4096);
+			ASSERT_EQ(1, replayer.replay(ring, { &consumer_sequence }));
+			ASSERT_EQ(0, ring[3].value);
+		}
+
+		TEST(journal_replayer_test, should_stop_segment_at_torn_record)
+		{
+			temp_directory dir;
+			write_journal(dir.get_path(), 5, 4096);
+			{
+				// Corrupt the payload of the fourth record.
+				const std::size_t offset = journal_format::SEGMENT_HEADER_LENGTH
+					+ 3 * journal_format::record_length(sizeof(replayed_event)) + journal_format::RECORD_HEADER_LENGTH;
+				std::fstream file(journal_format::segment_path(dir.get_path(), 0),
+					std::ios::in | std::ios::out | std::ios::binary);
+				file.seekp(offset);
+				file.put('\x7f');
+			}
+
+			ring_buffer_type ring;
+			sequence consumer_sequence;
+			ring.add_gating_sequences({ &consumer_sequence });
+			journal_replayer<replayed_event> replayer(dir.get_path());
+			ASSERT_EQ(3, replayer.replay(ring, { &consumer_sequence }));
+			ASSERT_EQ(2, replayer.get_last_journal_sequence());
+			ASSERT_EQ(200, ring[2].value);
+		}
+
+		TEST(journal_replayer_test, should_replay_nothing_from_empty_directory)
+		{
+			temp_directory dir;
+			ring_buffer_type ring;
+			journal_replayer<replayed_event> replayer(dir.get_path());
+			ASSERT_EQ(0, replayer.replay(ring));
+			ASSERT_EQ(-1, replayer.get_last_journal_sequence());
+		}
+	}
+}
@@ -0,0 +1,213 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+#include "support/stub_event_handler.h"
+#include "utils/count_down_latch.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			class stage_handler : public stub_event_handler<stub_event>
+			{
+			public:
+				stage_handler(int stage, std::vector<std::pair<int, int>>& received)
+					: stage_(stage),
+					  received_(received),
+					  latch_(nullptr),
+					  fail_start_(false),
+					  started_(0),
+					  shut_down_(0)
+				{
+				}
+
+				virtual void on_start()
+				{
+					if (fail_start_)
+						throw std::runtime_error("start failed");
+					started_++;
+				}
+
+				virtual void on_shutdown()
+				{
+					shut_down_++;
+				}
+
+				virtual void on_start_exception(const std::exception& ex)
+				{
+					throw std::runtime_error(ex.what());
+				}
+
+				virtual void on_event(stub_event& event, int64_t sequence, bool end_of_batch)
+				{
+					received_.push_back(std::make_pair(stage_, event.get_value()));
+					if (latch_ != nullptr)
+						latch_->count_down();
+				}
+
+				int stage_;
+				std::vector<std::pair<int, int>>& received_;
+				count_down_latch* latch_;
+				bool fail_start_;
+				int started_;
+				int shut_down_;
+			};
+
+			class journal_handler : public stage_handler
+			{
+			public:
+				using stage_handler::stage_handler;
+			};
+
+			class replication_handler : public stage_handler
+			{
+			public:
+				using stage_handler::stage_handler;
+			};
+
+			class business_handler : public stage_handler
+			{
+			public:
+				using stage_handler::stage_handler;
+			};
+		}
+
+		class pipeline_test : public testing::Test
+		{
+		protected:
+			typedef ring_buffer<stub_event, 8, yielding_wait_strategy<>, producer_type::single> ring_buffer_type;
+			typedef pipeline<ring_buffer_type, stage<journal_handler>, stage<replication_handler>,
+				stage<business_handler, 0, 1>> pipeline_type;
+
+			pipeline_test()
+				: journal_(0, received_),
+				  replication_(1, received_),
+				  business_(2, received_)
+			{
+			}
+
+			void publish(int count)
+			{
+				for (int i = 0; i < count; i++)
+				{
+					int64_t seq = ring_buffer_.next();
+					ring_buffer_[seq].set_value(i);
+					ring_buffer_.publish(seq);
+				}
+			}
+
+			ring_buffer_type ring_buffer_;
+			std::vector<std::pair<int, int>> received_;
+			journal_handler journal_;
+			replication_handler replication_;
+			business_handler business_;
+		};
+
+		TEST_F(pipeline_test, should_process_stages_in_dependency_order)
+		{
+			pipeline_type p(ring_buffer_, journal_, replication_, business_);
+			static_assert(pipeline_type::STAGE_COUNT == 3, "three stages");
+
+			publish(2);
+			ASSERT_EQ(6, p.process_available(8));
+			std::vector<std::pair<int, int>> expected { { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 }, { 2, 0 }, { 2, 1 } };
+			ASSERT_EQ(expected, received_);
+			ASSERT_EQ(0, p.process_available(8));
+		}
+
+		TEST_F(pipeline_test, should_wait_for_all_dependencies_and_gate_on_last_stage)
+		{
+			pipeline_type p(ring_buffer_, journal_, replication_, business_);
+			publish(3);
+			ASSERT_EQ(5, ring_buffer_.remaining_capacity());
+
+			ASSERT_EQ(3, p.get_processor<0>().process_available(8));
+			ASSERT_EQ(0, p.get_processor<2>().process_available(8));
+			ASSERT_EQ(1, p.get_processor<1>().process_available(1));
+			ASSERT_EQ(1, p.get_processor<2>().process_available(8));
+			ASSERT_EQ(6, ring_buffer_.remaining_capacity());
+
+			ASSERT_EQ(4, p.process_available(8));
+			ASSERT_EQ(8, ring_buffer_.remaining_capacity());
+		}
+
+		TEST_F(pipeline_test, should_run_stages_on_agent_runner)
+		{
+			pipeline_type p(ring_buffer_, journal_, replication_, business_);
+			count_down_latch latch(20);
+			business_.latch_ = &latch;
+			agent_runner<yielding_idle_strategy> runner;
+			runner.add(p);
+
+			std::thread runner_thread([&runner] { runner.run(); });
+			publish(20);
+			ASSERT_TRUE(latch.wait(std::chrono::seconds(5)));
+			runner.halt();
+			runner_thread.join();
+
+			ASSERT_EQ(60u, received_.size());
+		}
+
+		TEST_F(pipeline_test, should_shut_down_started_stages_when_a_later_stage_fails_to_start)
+		{
+			pipeline_type p(ring_buffer_, journal_, replication_, business_);
+			business_.fail_start_ = true;
+			ASSERT_THROW(p.start(), std::runtime_error);
+
+			ASSERT_EQ(1, journal_.started_);
+			ASSERT_EQ(1, journal_.shut_down_);
+			ASSERT_EQ(1, replication_.started_);
+			ASSERT_EQ(1, replication_.shut_down_);
+			ASSERT_EQ(0, business_.shut_down_);
+			ASSERT_FALSE(p.get_processor<0>().is_running());
+			ASSERT_FALSE(p.get_processor<1>().is_running());
+			ASSERT_FALSE(p.get_processor<2>().is_running());
+
+			business_.fail_start_ = false;
+			p.start();
+			ASSERT_TRUE(p.get_processor<2>().is_running());
+			p.shutdown();
+		}
+	}
+}
@@ -0,0 +1,228 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+#include "support/stub_event_handler.h"
+#include "utils/count_down_latch.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			struct priority_test_tag
+			{
+			};
+
+			typedef shared_wait_strategy<blocking_wait_strategy, priority_test_tag> test_wait_strategy;
+			typedef ring_buffer<stub_event, 8, test_wait_strategy, producer_type::single> ring_buffer_type;
+
+			class lane_recording_handler : public stub_event_handler<stub_event>
+			{
+			public:
+				lane_recording_handler(int lane, std::vector<std::pair<int, int>>& received)
+					: lane_(lane),
+					  received_(received),
+					  latch_(nullptr),
+					  feed_(nullptr),
+					  failing_value_(-1),
+					  timeouts_(0)
+				{
+				}
+
+				virtual void on_event(stub_event& event, int64_t sequence, bool end_of_batch)
+				{
+					if (event.get_value() == failing_value_)
+						throw std::runtime_error("failing event");
+					received_.push_back(std::make_pair(lane_, event.get_value()));
+					if (feed_ != nullptr)
+					{
+						int64_t seq = feed_->next();
+						(*feed_)[seq].set_value(event.get_value() + 1);
+						feed_->publish(seq);
+					}
+					if (latch_ != nullptr)
+						latch_->count_down();
+				}
+
+				virtual void on_timeout(int64_t sequence)
+				{
+					timeouts_++;
+				}
+
+				int lane_;
+				std::vector<std::pair<int, int>>& received_;
+				count_down_latch* latch_;
+				ring_buffer_type* feed_;
+				int failing_value_;
+				std::atomic<int> timeouts_;
+			};
+
+			void publish(ring_buffer_type& ring, int value)
+			{
+				int64_t seq = ring.next();
+				ring[seq].set_value(value);
+				ring.publish(seq);
+			}
+		}
+
+		class priority_event_processor_test : public testing::Test
+		{
+		protected:
+			priority_event_processor_test()
+				: high_handler_(0, received_),
+				  low_handler_(1, received_),
+				  high_lane_(high_ring_, high_ring_.new_barrier(), high_handler_, 10),
+				  low_lane_(low_ring_, low_ring_.new_barrier(), low_handler_, 1)
+			{
+				high_ring_.add_gating_sequences({ &high_lane_.get_sequence() });
+				low_ring_.add_gating_sequences({ &low_lane_.get_sequence() });
+			}
+
+			ring_buffer_type high_ring_;
+			ring_buffer_type low_ring_;
+			std::vector<std::pair<int, int>> received_;
+			lane_recording_handler high_handler_;
+			lane_recording_handler low_handler_;
+			priority_lane<ring_buffer_type> high_lane_;
+			priority_lane<ring_buffer_type> low_lane_;
+		};
+
+		TEST_F(priority_event_processor_test, should_drain_higher_priority_lane_first)
+		{
+			priority_event_processor<test_wait_strategy> processor({ &low_lane_, &high_lane_ });
+			publish(low_ring_, 1);
+			publish(low_ring_, 2);
+			publish(high_ring_, 10);
+			publish(high_ring_, 11);
+
+			ASSERT_TRUE(processor.process_once());
+			ASSERT_TRUE(processor.process_once());
+			ASSERT_FALSE(processor.process_once());
+
+			std::vector<std::pair<int, int>> expected { { 0, 10 }, { 0, 11 }, { 1, 1 }, { 1, 2 } };
+			ASSERT_EQ(expected, received_);
+		}
+
+		TEST_F(priority_event_processor_test, should_serve_starved_lane)
+		{
+			priority_event_processor<test_wait_strategy, 2> processor({ &high_lane_, &low_lane_ });
+			high_handler_.feed_ = &high_ring_;
+			publish(low_ring_, 1);
+			publish(high_ring_, 10);
+
+			for (int i = 0; i < 4; i++)
+				ASSERT_TRUE(processor.process_once());
+
+			std::vector<std::pair<int, int>> expected { { 0, 10 }, { 0, 11 }, { 1, 1 }, { 0, 12 } };
+			ASSERT_EQ(expected, received_);
+		}
+
+		TEST_F(priority_event_processor_test, should_limit_batch_per_round)
+		{
+			priority_lane<ring_buffer_type> capped_lane(low_ring_, low_ring_.new_barrier(), low_handler_, 1, 2);
+			priority_event_processor<test_wait_strategy> processor({ &high_lane_, &capped_lane });
+			for (int i = 1; i <= 5; i++)
+				publish(low_ring_, i);
+
+			ASSERT_TRUE(processor.process_once());
+			ASSERT_EQ(1, capped_lane.get_sequence().get());
+			publish(high_ring_, 10);
+			while (processor.process_once())
+			{
+			}
+
+			std::vector<std::pair<int, int>> expected
+				{ { 1, 1 }, { 1, 2 }, { 0, 10 }, { 1, 3 }, { 1, 4 }, { 1, 5 } };
+			ASSERT_EQ(expected, received_);
+			ASSERT_THROW(priority_lane<ring_buffer_type>(low_ring_, low_ring_.new_barrier(), low_handler_, 1, 0),
+				std::invalid_argument);
+		}
+
+		TEST_F(priority_event_processor_test, should_halt_on_exception_handler_request)
+		{
+			priority_lane<ring_buffer_type, halting_exception_handler> halting_lane(
+				low_ring_, low_ring_.new_barrier(), low_handler_, 1);
+			priority_event_processor<test_wait_strategy> processor({ &high_lane_, &halting_lane });
+			low_handler_.failing_value_ = 2;
+			for (int i = 1; i <= 3; i++)
+				publish(low_ring_, i);
+
+			processor.run();
+
+			std::vector<std::pair<int, int>> expected { { 1, 1 } };
+			ASSERT_EQ(expected, received_);
+			ASSERT_EQ(0, halting_lane.get_sequence().get());
+			ASSERT_FALSE(processor.is_running());
+		}
+
+		TEST_F(priority_event_processor_test, should_notify_every_lane_on_timeout)
+		{
+			priority_event_processor<timeout_blocking_wait_strategy<1000000>> processor({ &high_lane_, &low_lane_ });
+			std::thread processor_thread([&processor] { processor.run(); });
+			while (high_handler_.timeouts_.load() == 0 || low_handler_.timeouts_.load() == 0)
+				std::this_thread::yield();
+			processor.halt();
+			processor_thread.join();
+
+			ASSERT_TRUE(received_.empty());
+		}
+
+		TEST_F(priority_event_processor_test, should_wake_up_on_publish_to_any_lane)
+		{
+			priority_event_processor<test_wait_strategy> processor({ &high_lane_, &low_lane_ });
+			count_down_latch latch(2);
+			low_handler_.latch_ = &latch;
+			high_handler_.latch_ = &latch;
+
+			std::thread processor_thread([&processor] { processor.run(); });
+			publish(low_ring_, 1);
+			publish(high_ring_, 10);
+			latch.wait();
+			processor.halt();
+			processor_thread.join();
+
+			ASSERT_EQ(2u, received_.size());
+			ASSERT_FALSE(processor.is_running());
+		}
+	}
+}
@@ -0,0 +1,205 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			struct message
+			{
+				int32_t msg_type_id;
+				std::string payload;
+			};
+
+			struct message_collector
+			{
+				void operator()(int32_t msg_type_id, const uint8_t* data, std::size_t length)
+				{
+					messages.push_back({ msg_type_id, std::string(reinterpret_cast<const char*>(data), length) });
+				}
+
+				std::vector<message> messages;
+			};
+		}
+
+		typedef record_ring_buffer<256, busy_spin_wait_strategy> test_record_ring_buffer;
+		typedef record_ring_buffer<256, busy_spin_wait_strategy, producer_type::single> test_single_record_ring_buffer;
+
+		TEST(record_ring_buffer_test, should_write_and_read_message)
+		{
+			test_record_ring_buffer ring;
+			ring.write(7, "hello", 5);
+			ASSERT_EQ(16u, ring.size());
+
+			message_collector collector;
+			ASSERT_EQ(1, ring.read(collector));
+			ASSERT_EQ(1u, collector.messages.size());
+			ASSERT_EQ(7, collector.messages[0].msg_type_id);
+			ASSERT_EQ("hello", collector.messages[0].payload);
+			ASSERT_EQ(0u, ring.size());
+			ASSERT_EQ(0, ring.read(collector));
+		}
+
+		TEST(record_ring_buffer_test, should_not_read_claimed_message_until_committed)
+		{
+			test_record_ring_buffer ring;
+			int64_t index = ring.claim(3, sizeof(int64_t));
+			int64_t value = 42;
+			std::memcpy(ring.get_data(index), &value, sizeof(value));
+
+			message_collector collector;
+			ASSERT_EQ(0, ring.read(collector));
+			ring.commit(index);
+			ASSERT_EQ(1, ring.read(collector));
+			ASSERT_EQ(3, collector.messages[0].msg_type_id);
+			ASSERT_EQ(std::string(reinterpret_cast<const char*>(&value), sizeof(value)),
+				collector.messages[0].payload);
+		}
+
+		TEST(record_ring_buffer_test, should_skip_aborted_message)
+		{
+			test_record_ring_buffer ring;
+			ring.abort(ring.claim(1, 4));
+			ring.write(2, "abcd", 4);
+
+			message_collector collector;
+			ASSERT_EQ(1, ring.read(collector));
+			ASSERT_EQ(2, collector.messages[0].msg_type_id);
+			ASSERT_EQ(0u, ring.size());
+		}
+
+		TEST(record_ring_buffer_test, should_limit_messages_read)
+		{
+			test_record_ring_buffer ring;
+			for (int i = 0; i < 3; i++)
+				ring.write(1, "x", 1);
+
+			message_collector collector;
+			ASSERT_EQ(2, ring.read(collector, 2));
+			ASSERT_EQ(1, ring.read(collector, 2));
+		}
+
+		TEST(record_ring_buffer_test, should_pad_at_end_of_buffer)
+		{
+			test_single_record_ring_buffer ring;
+			message_collector collector;
+			char payload[24] = {};
+			// 7 records of 32 bytes leave 32 bytes at the end; consume them to free the start.
+			for (int i = 0; i < 7; i++)
+				ring.write(1, payload, sizeof(payload));
+			ASSERT_EQ(7, ring.read(collector));
+
+			ring.write(2, "0123456789abcdef0123456789abcdef", 32);
+			ASSERT_EQ(32u + 40u, ring.size());
+
+			collector.messages.clear();
+			ASSERT_EQ(0, ring.read(collector));
+			ASSERT_EQ(1, ring.read(collector));
+			ASSERT_EQ(2, collector.messages[0].msg_type_id);
+			ASSERT_EQ("0123456789abcdef0123456789abcdef", collector.messages[0].payload);
+		}
+
+		TEST(record_ring_buffer_test, should_throw_when_full)
+		{
+			test_record_ring_buffer ring;
+			char payload[24] = {};
+			for (int i = 0; i < 8; i++)
+				ring.try_claim(1, sizeof(payload));
+			ASSERT_THROW(ring.try_claim(1, 1), insufficient_capacity_exception);
+		}
+
+		TEST(record_ring_buffer_test, should_reject_invalid_messages)
+		{
+			test_record_ring_buffer ring;
+			ASSERT_THROW(ring.try_claim(0, 1), std::invalid_argument);
+			ASSERT_THROW(ring.try_claim(1, 33), std::invalid_argument);
+		}
+
+		TEST(record_ring_buffer_test, should_throw_alert_exception_when_alerted)
+		{
+			test_record_ring_buffer ring;
+			ring.alert();
+			ASSERT_THROW(ring.wait_for_records(), alert_exception);
+			ring.clear_alert();
+			ring.write(1, "x", 1);
+			ring.wait_for_records();
+		}
+
+		TEST(record_ring_buffer_test, should_deliver_messages_from_multiple_producers)
+		{
+			static constexpr int PRODUCERS = 3;
+			static constexpr int64_t MESSAGES = 20000;
+			record_ring_buffer<1024, yielding_wait_strategy<>> ring;
+
+			std::vector<std::thread> producers;
+			for (int p = 0; p < PRODUCERS; p++)
+			{
+				producers.emplace_back([&ring, p]
+				{
+					for (int64_t i = 0; i < MESSAGES; i++)
+						ring.write(p + 1, &i, sizeof(i));
+				});
+			}
+
+			int64_t expected[PRODUCERS] = {};
+			bool in_order = true;
+			int64_t total = 0;
+			while (total < PRODUCERS * MESSAGES)
+			{
+				ring.wait_for_records();
+				total += ring.read([&](int32_t msg_type_id, const uint8_t* data, std::size_t length)
+				{
+					int64_t value;
+					std::memcpy(&value, data, length);
+					in_order = in_order && value == expected[msg_type_id - 1]++;
+				});
+			}
+			for (auto& producer : producers)
+				producer.join();
+
+			ASSERT_TRUE(in_order);
+			for (int p = 0; p < PRODUCERS; p++)
+				ASSERT_EQ(MESSAGES, expected[p]);
+		}
+	}
+}
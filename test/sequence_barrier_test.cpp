@@ -28,6 +28,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -109,14 +110,20 @@ namespace disruptor4cpp
 				return sequence_.load(std::memory_order_acquire);
 			}
 
+			int64_t get_relaxed() const
+			{
+				return sequence_.load(std::memory_order_relaxed);
+			}
+
 			void set(int64_t value)
 			{
 				sequence_.store(value, std::memory_order_release);
 			}
 
-			bool compare_and_set(int64_t expected_value, int64_t new_value)
+			bool compare_and_set(int64_t expected_value, int64_t new_value,
+				std::memory_order order = std::memory_order_seq_cst)
 			{
-				return sequence_.compare_exchange_weak(expected_value, new_value);
+				return sequence_.compare_exchange_weak(expected_value, new_value, order);
 			}
 
 			int64_t increment_and_get()
@@ -336,5 +343,34 @@ namespace disruptor4cpp
 			seq_barrier->clear_alert();
 			ASSERT_FALSE(seq_barrier->is_alerted());
 		}
+
+		TEST_F(sequencer_barrier_test, should_get_available_sequence_without_waiting)
+		{
+			auto seq_barrier = ring_buffer_.new_barrier();
+			ASSERT_EQ(-1, seq_barrier->get_available_sequence(0));
+
+			int64_t hi = ring_buffer_.next(3);
+			ring_buffer_.publish(hi - 2);
+			ring_buffer_.publish(hi);
+			ASSERT_EQ(hi - 2, seq_barrier->get_available_sequence(0));
+
+			ring_buffer_.publish(hi - 1);
+			ASSERT_EQ(hi, seq_barrier->get_available_sequence(0));
+		}
+
+		TEST_F(sequencer_barrier_test, should_wait_for_static_dependencies)
+		{
+			fill_ring_buffer(this->ring_buffer_, 10);
+			sequence sequence1(9);
+			sequence sequence2(4);
+
+			auto seq_barrier = ring_buffer_.new_barrier(std::array<sequence*, 2> { { &sequence1, &sequence2 } });
+			ASSERT_EQ(4, seq_barrier->get_cursor());
+			ASSERT_EQ(4, seq_barrier->wait_for(3));
+			ASSERT_EQ(4, seq_barrier->get_available_sequence(5));
+
+			sequence2.set(9);
+			ASSERT_EQ(9, seq_barrier->wait_for(5));
+		}
 	}
 }
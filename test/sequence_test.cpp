@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		TEST(sequence_test, should_start_with_initial_value)
+		{
+			sequence seq;
+			ASSERT_EQ(-1, seq.get());
+			ASSERT_EQ(-1, seq.get_relaxed());
+		}
+
+		TEST(sequence_test, should_read_own_writes_relaxed)
+		{
+			sequence seq(3);
+			seq.set(7);
+			ASSERT_EQ(7, seq.get_relaxed());
+			ASSERT_EQ(7, seq.get());
+		}
+
+		TEST(sequence_test, should_compare_and_set_with_explicit_orders)
+		{
+			sequence seq(5);
+			ASSERT_FALSE(seq.compare_and_set(4, 6, std::memory_order_relaxed));
+			ASSERT_EQ(5, seq.get());
+
+			while (!seq.compare_and_set(5, 6, std::memory_order_acq_rel, std::memory_order_relaxed))
+			{
+			}
+			ASSERT_EQ(6, seq.get());
+		}
+
+		TEST(sequence_test, should_add_and_get)
+		{
+			sequence seq(0);
+			ASSERT_EQ(1, seq.increment_and_get());
+			ASSERT_EQ(11, seq.add_and_get(10));
+		}
+
+		TEST(sequence_test, should_publish_data_with_ordered_set)
+		{
+			static constexpr int ITERATIONS = 10000;
+			sequence seq;
+			int data[ITERATIONS];
+
+			std::thread writer([&seq, &data]
+				{
+					for (int i = 0; i < ITERATIONS; i++)
+					{
+						data[i] = i * 2;
+						seq.set(i);
+					}
+				});
+
+			int64_t last = sequence::INITIAL_VALUE;
+			while (last < ITERATIONS - 1)
+			{
+				int64_t current = seq.get();
+				for (int64_t i = last + 1; i <= current; i++)
+					ASSERT_EQ(i * 2, data[i]);
+				last = current;
+			}
+			writer.join();
+		}
+	}
+}
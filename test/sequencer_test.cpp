@@ -59,6 +59,11 @@ namespace disruptor4cpp
 			static constexpr producer_type value = producer_type::multi;
 		};
 
+		struct producer_type_multi_fetch_add
+		{
+			static constexpr producer_type value = producer_type::multi_fetch_add;
+		};
+
 		template <typename TProducerType>
 		class sequencer_test : public testing::Test
 		{
@@ -72,7 +77,8 @@ namespace disruptor4cpp
 			sequence gating_sequence_;
 		};
 
-		typedef ::testing::Types<producer_type_single, producer_type_multi> producer_types;
+		typedef ::testing::Types<producer_type_single, producer_type_multi,
+			producer_type_multi_fetch_add> producer_types;
 		TYPED_TEST_CASE(sequencer_test, producer_types);
 
 		TYPED_TEST(sequencer_test, should_start_with_initial_value)
@@ -109,6 +115,10 @@ namespace disruptor4cpp
 
 		TYPED_TEST(sequencer_test, should_hold_up_publisher_when_buffer_is_full)
 		{
+			// A fetch_add claim moves the cursor before it waits; see
+			// fetch_add_sequencer_test.should_reserve_beyond_buffer_when_buffer_is_full.
+			if (TypeParam::value == producer_type::multi_fetch_add)
+				return;
 			this->sequencer_.add_gating_sequences(std::vector<sequence*> { &this->gating_sequence_ });
 			int64_t seq = this->sequencer_.next(this->BUFFER_SIZE);
 			this->sequencer_.publish(seq - (this->BUFFER_SIZE - 1), seq);
@@ -249,6 +259,36 @@ namespace disruptor4cpp
 			ASSERT_EQ(seq + 1, this->sequencer_.next());
 		}
 
+		TYPED_TEST(sequencer_test, should_claim_concurrently_without_losing_sequences)
+		{
+			static constexpr int PRODUCERS = 3;
+			static constexpr int CLAIMS = 5000;
+			if (TypeParam::value == producer_type::single)
+				return;
+			this->sequencer_.add_gating_sequences(std::vector<sequence*> { &this->gating_sequence_ });
+
+			std::vector<std::thread> producers;
+			for (int p = 0; p < PRODUCERS; p++)
+			{
+				producers.emplace_back([this]
+				{
+					for (int i = 0; i < CLAIMS; i++)
+						this->sequencer_.publish(this->sequencer_.next());
+				});
+			}
+			int64_t next = 0;
+			while (next < PRODUCERS * CLAIMS)
+			{
+				if (this->sequencer_.is_available(next))
+					this->gating_sequence_.set(next++);
+				else
+					std::this_thread::yield();
+			}
+			for (auto& producer : producers)
+				producer.join();
+			ASSERT_EQ(PRODUCERS * CLAIMS - 1, this->sequencer_.get_cursor());
+		}
+
 		TYPED_TEST(sequencer_test, should_not_allow_bulk_next_less_than_zero)
 		{
 			ASSERT_THROW(this->sequencer_.next(-1), std::invalid_argument);
@@ -268,5 +308,33 @@ namespace disruptor4cpp
 		{
 			ASSERT_THROW(this->sequencer_.try_next(0), std::invalid_argument);
 		}
+
+		TEST(fetch_add_sequencer_test, should_reserve_beyond_buffer_when_buffer_is_full)
+		{
+			typedef sequencer_traits<16, blocking_wait_strategy, sequence,
+				producer_type::multi_fetch_add>::sequencer_type sequencer_type;
+			sequencer_type sequencer;
+			sequence gating_sequence;
+			sequencer.add_gating_sequences(std::vector<sequence*> { &gating_sequence });
+			int64_t seq = sequencer.next(16);
+			sequencer.publish(seq - 15, seq);
+
+			std::thread t([&sequencer] { sequencer.publish(sequencer.next()); });
+			while (sequencer.get_cursor() != 16)
+				std::this_thread::yield();
+
+			// The cursor already covers the waiting claim, so a barrier sees sequence 16 as
+			// claimed, but it is not published and no capacity is reported.
+			ASSERT_EQ(15, sequencer.get_highest_published_sequence(0, sequencer.get_cursor()));
+			ASSERT_FALSE(sequencer.is_available(16));
+			ASSERT_EQ(0, sequencer.remaining_capacity());
+
+			gating_sequence.set(0);
+			t.join();
+			ASSERT_TRUE(sequencer.is_available(16));
+			ASSERT_EQ(0, sequencer.remaining_capacity());
+			gating_sequence.set(16);
+			ASSERT_EQ(16, sequencer.remaining_capacity());
+		}
 	}
 }
@@ -0,0 +1,173 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		class sharded_ring_buffer_test : public testing::Test
+		{
+		protected:
+			typedef ring_buffer<stub_event, 8, yielding_wait_strategy<>, producer_type::multi> ring_buffer_type;
+			typedef sharded_ring_buffer<ring_buffer_type, 4> sharded_type;
+
+			sharded_ring_buffer_test()
+			{
+				for (std::size_t i = 0; i < sharded_.get_shard_count(); i++)
+					sharded_.get_shard(i).add_gating_sequences({ &consumer_sequences_[i] });
+			}
+
+			sharded_type sharded_;
+			sequence consumer_sequences_[4];
+		};
+
+		TEST_F(sharded_ring_buffer_test, should_route_same_key_to_same_shard_in_order)
+		{
+			const std::size_t index = sharded_.get_shard_index(42);
+			for (int i = 0; i < 5; i++)
+			{
+				int64_t seq = sharded_.publish_event(42, [i](stub_event& event, int64_t) { event.set_value(i); });
+				ASSERT_EQ(i, seq);
+				ASSERT_EQ(i, sharded_.get_shard(index)[seq].get_value());
+			}
+			ASSERT_EQ(5, sharded_.get_metrics(index).claimed);
+			ASSERT_EQ(3, sharded_.get_metrics(index).remaining_capacity);
+		}
+
+		TEST_F(sharded_ring_buffer_test, should_spread_sequential_keys_over_shards)
+		{
+			std::set<std::size_t> used;
+			for (int key = 0; key < 16; key++)
+				used.insert(sharded_.get_shard_index(key));
+			ASSERT_EQ(4u, used.size());
+		}
+
+		TEST_F(sharded_ring_buffer_test, should_aggregate_remaining_capacity)
+		{
+			ASSERT_EQ(32, sharded_.remaining_capacity());
+			sharded_.publish_event(1, [](stub_event&, int64_t) { });
+			sharded_.publish_event(2, [](stub_event&, int64_t) { });
+			ASSERT_EQ(30, sharded_.remaining_capacity());
+		}
+
+		TEST_F(sharded_ring_buffer_test, should_count_rejections_when_shard_is_full)
+		{
+			const std::size_t index = sharded_.get_shard_index(7);
+			for (int i = 0; i < 8; i++)
+				sharded_.try_publish_event(7, [](stub_event&, int64_t) { });
+			ASSERT_THROW(sharded_.try_publish_event(7, [](stub_event&, int64_t) { }),
+				insufficient_capacity_exception);
+			ASSERT_EQ(1u, sharded_.get_metrics(index).rejected);
+			ASSERT_EQ(0, sharded_.get_metrics(index).remaining_capacity);
+		}
+
+		TEST_F(sharded_ring_buffer_test, should_publish_slot_when_translator_throws)
+		{
+			const std::size_t index = sharded_.get_shard_index(3);
+			ASSERT_THROW(sharded_.publish_event(3, [](stub_event&, int64_t) { throw std::runtime_error("failed"); }),
+				std::runtime_error);
+			ASSERT_TRUE(sharded_.get_shard(index).is_available(0));
+		}
+
+		TEST_F(sharded_ring_buffer_test, should_keep_per_key_order_with_concurrent_producers)
+		{
+			static constexpr int EVENTS_PER_KEY = 2000;
+			std::vector<std::thread> producers;
+			std::vector<std::vector<int>> received(4);
+			std::vector<std::thread> consumers;
+			for (std::size_t i = 0; i < 4; i++)
+			{
+				consumers.emplace_back([this, i, &received]
+				{
+					ring_buffer_type& shard = sharded_.get_shard(i);
+					auto barrier = shard.new_barrier();
+					int64_t next = 0;
+					while (true)
+					{
+						int64_t available = barrier->wait_for(next);
+						for (; next <= available; next++)
+						{
+							int value = shard[next].get_value();
+							if (value < 0)
+								return;
+							received[i].push_back(value);
+						}
+						consumer_sequences_[i].set(available);
+					}
+				});
+			}
+			for (int key = 0; key < 4; key++)
+			{
+				producers.emplace_back([this, key]
+				{
+					for (int i = 0; i < EVENTS_PER_KEY; i++)
+						sharded_.publish_event(key, [key, i](stub_event& event, int64_t) { event.set_value(key * EVENTS_PER_KEY + i); });
+				});
+			}
+			for (auto& producer : producers)
+				producer.join();
+			for (std::size_t i = 0; i < 4; i++)
+			{
+				ring_buffer_type& shard = sharded_.get_shard(i);
+				int64_t seq = shard.next();
+				shard[seq].set_value(-1);
+				shard.publish(seq);
+			}
+			for (auto& consumer : consumers)
+				consumer.join();
+
+			for (int key = 0; key < 4; key++)
+			{
+				const std::vector<int>& values = received[sharded_.get_shard_index(key)];
+				int expected = key * EVENTS_PER_KEY;
+				for (int value : values)
+				{
+					if (value / EVENTS_PER_KEY == key)
+					{
+						ASSERT_EQ(expected, value);
+						expected++;
+					}
+				}
+				ASSERT_EQ((key + 1) * EVENTS_PER_KEY, expected);
+			}
+		}
+	}
+}
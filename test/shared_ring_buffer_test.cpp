@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include "support/stub_event_handler.h"
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			struct shared_event
+			{
+				int64_t value;
+			};
+
+			class summing_handler : public stub_event_handler<shared_event>
+			{
+			public:
+				summing_handler()
+					: sum_(0),
+					  count_(0)
+				{
+				}
+
+				virtual void on_event(shared_event& event, int64_t sequence, bool end_of_batch)
+				{
+					sum_ += event.value;
+					count_.fetch_add(1, std::memory_order_release);
+				}
+
+				int64_t sum_;
+				std::atomic<int64_t> count_;
+			};
+
+			std::string segment_name(const char* suffix)
+			{
+				return "/disruptor4cpp_test_" + std::to_string(::getpid()) + "_" + suffix;
+			}
+		}
+
+		TEST(shared_ring_buffer_test, should_share_ring_buffer_between_mappings)
+		{
+			typedef shared_ring_buffer<shared_event, 4, yielding_wait_strategy<>, producer_type::single, 2> shared_type;
+			const std::string name = segment_name("mappings");
+			shared_type::unlink(name);
+
+			auto producer = shared_type::create(name, 1);
+			auto consumer = shared_type::open(name);
+			ASSERT_NE(producer->get_region().get_address(), consumer->get_region().get_address());
+			ASSERT_EQ(1u, consumer->get_consumer_count());
+
+			auto& producer_ring = producer->get_ring_buffer();
+			for (int64_t i = 0; i < 4; i++)
+			{
+				int64_t seq = producer_ring.next();
+				producer_ring[seq].value = i * 10;
+				producer_ring.publish(seq);
+			}
+			ASSERT_THROW(producer_ring.try_next(), insufficient_capacity_exception);
+
+			auto& consumer_ring = consumer->get_ring_buffer();
+			auto barrier = consumer_ring.new_barrier();
+			ASSERT_EQ(3, barrier->wait_for(0));
+			ASSERT_EQ(30, consumer_ring[3].value);
+
+			consumer->get_consumer_sequence(0).set(1);
+			ASSERT_EQ(2, producer_ring.remaining_capacity());
+			ASSERT_EQ(4, producer_ring.try_next());
+			ASSERT_THROW(consumer->get_consumer_sequence(1), std::out_of_range);
+
+			shared_type::unlink(name);
+		}
+
+		TEST(shared_ring_buffer_test, should_reject_mismatched_layout)
+		{
+			typedef shared_ring_buffer<shared_event, 4, busy_spin_wait_strategy, producer_type::single> small_type;
+			typedef shared_ring_buffer<shared_event, 8, busy_spin_wait_strategy, producer_type::single> large_type;
+			const std::string name = segment_name("layout");
+			small_type::unlink(name);
+
+			auto segment = small_type::create(name, 1);
+			ASSERT_THROW(small_type::create(name, 1), std::system_error);
+			ASSERT_THROW(large_type::open(name), std::runtime_error);
+			small_type::unlink(name);
+		}
+
+		TEST(shared_ring_buffer_test, should_process_events_published_by_another_process)
+		{
+			typedef shared_ring_buffer<shared_event, 64, futex_wait_strategy, producer_type::multi> shared_type;
+			static constexpr int64_t EVENTS = 10000;
+			const std::string name = segment_name("process");
+			shared_type::unlink(name);
+
+			auto segment = shared_type::create(name, 1);
+			pid_t pid = ::fork();
+			ASSERT_NE(-1, pid);
+			if (pid == 0)
+			{
+				auto child = shared_type::open(name);
+				auto& ring = child->get_ring_buffer();
+				for (int64_t i = 1; i <= EVENTS; i++)
+				{
+					int64_t seq = ring.next();
+					ring[seq].value = i;
+					ring.publish(seq);
+				}
+				::_exit(0);
+			}
+
+			auto& ring = segment->get_ring_buffer();
+			summing_handler handler;
+			batch_event_processor<shared_type::ring_buffer_type> processor(
+				ring, ring.new_barrier(), handler, &segment->get_consumer_sequence(0));
+			std::thread processor_thread([&processor] { processor.run(); });
+			while (handler.count_.load(std::memory_order_acquire) < EVENTS)
+				std::this_thread::yield();
+			processor.halt();
+			processor_thread.join();
+
+			int status = 0;
+			ASSERT_EQ(pid, ::waitpid(pid, &status, 0));
+			ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+			ASSERT_EQ(EVENTS * (EVENTS + 1) / 2, handler.sum_);
+			ASSERT_EQ(EVENTS - 1, segment->get_consumer_sequence(0).get());
+			shared_type::unlink(name);
+		}
+	}
+}
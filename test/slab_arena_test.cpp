@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <disruptor4cpp/disruptor4cpp.h>
+#include <disruptor4cpp/utils/arena_allocator.h>
+#include <disruptor4cpp/utils/slab_arena.h>
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		namespace
+		{
+			struct payload_event
+			{
+				payload_event() = default;
+
+				explicit payload_event(arena_region& region)
+					: name(arena_allocator<char>(region)),
+					  values(arena_allocator<int>(region))
+				{
+					name.reserve(64);
+					values.reserve(16);
+				}
+
+				arena_string name;
+				arena_vector<int> values;
+			};
+
+			typedef ring_buffer<payload_event, 4, busy_spin_wait_strategy, producer_type::single> payload_ring_type;
+		}
+
+		TEST(slab_arena_test, should_roll_back_last_allocation)
+		{
+			alignas(16) char buffer[64];
+			arena_region region(buffer, sizeof(buffer));
+			void* first = region.allocate(8, 8);
+			void* second = region.allocate(16, 8);
+			EXPECT_EQ(24, region.get_used());
+			region.deallocate(first, 8);
+			EXPECT_EQ(24, region.get_used());
+			region.deallocate(second, 16);
+			EXPECT_EQ(8, region.get_used());
+			region.reset();
+			EXPECT_EQ(0, region.get_used());
+			EXPECT_EQ(0, region.get_upstream_allocations());
+		}
+
+		TEST(slab_arena_test, should_fall_back_upstream_when_exhausted)
+		{
+			alignas(16) char buffer[32];
+			arena_region region(buffer, sizeof(buffer));
+			void* inside = region.allocate(24, 8);
+			void* outside = region.allocate(24, 8);
+			EXPECT_TRUE(region.contains(inside));
+			EXPECT_FALSE(region.contains(outside));
+			EXPECT_EQ(1, region.get_upstream_allocations());
+			region.deallocate(outside, 24);
+			region.deallocate(inside, 24);
+			EXPECT_EQ(0, region.get_used());
+		}
+
+		TEST(slab_arena_test, should_align_regions_to_cache_lines)
+		{
+			slab_arena arena(3, 100);
+			EXPECT_EQ(3, arena.get_region_count());
+			EXPECT_EQ(0, arena.get_region_size() % CACHE_LINE_SIZE);
+			for (std::size_t i = 0; i < arena.get_region_count(); i++)
+			{
+				void* ptr = arena.get_region(i).allocate(1, 1);
+				EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ptr) % CACHE_LINE_SIZE);
+			}
+			EXPECT_THROW(slab_arena(0, 100), std::invalid_argument);
+		}
+
+		TEST(slab_arena_test, should_publish_without_allocating_in_steady_state)
+		{
+			slab_arena arena(payload_ring_type::BUFFER_SIZE, 256);
+			payload_ring_type ring([&arena](std::size_t i) { return payload_event(arena.get_region(i)); });
+			std::size_t used[payload_ring_type::BUFFER_SIZE];
+			for (std::size_t i = 0; i < payload_ring_type::BUFFER_SIZE; i++)
+			{
+				EXPECT_EQ(&arena.get_region(i), ring[i].name.get_allocator().get_region());
+				used[i] = arena.get_region(i).get_used();
+			}
+
+			const std::string names[] = { "short", "a name long enough to defeat the small string buffer" };
+			for (int n = 0; n < 100; n++)
+			{
+				int64_t seq = ring.next();
+				payload_event& event = ring[seq];
+				event.name.assign(names[n % 2].begin(), names[n % 2].end());
+				event.values.clear();
+				for (int v = 0; v <= n % 16; v++)
+					event.values.push_back(v);
+				ring.publish(seq);
+			}
+
+			EXPECT_EQ(0, arena.get_upstream_allocations());
+			for (std::size_t i = 0; i < payload_ring_type::BUFFER_SIZE; i++)
+				EXPECT_EQ(used[i], arena.get_region(i).get_used());
+			EXPECT_EQ(names[1], std::string(ring[97].name.c_str()));
+		}
+
+		TEST(slab_arena_test, should_copy_out_of_arena)
+		{
+			slab_arena arena(1, 256);
+			payload_event event(arena.get_region(0));
+			event.name.assign("payload");
+			event.values.push_back(1);
+
+			payload_event copy(event);
+			EXPECT_EQ(nullptr, copy.name.get_allocator().get_region());
+			EXPECT_EQ(nullptr, copy.values.get_allocator().get_region());
+			EXPECT_EQ("payload", std::string(copy.name.c_str()));
+			EXPECT_EQ(0, arena.get_upstream_allocations());
+
+			copy = event;
+			EXPECT_EQ(nullptr, copy.name.get_allocator().get_region());
+		}
+	}
+}
@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_TEST_SUPPORT_STUB_EVENT_HANDLER_H_
+#define DISRUPTOR4CPP_TEST_SUPPORT_STUB_EVENT_HANDLER_H_
+
+#include <cstdint>
+#include <exception>
+
+#include <disruptor4cpp/event_handler.h>
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		// Event handler doing nothing; tests override the callbacks they observe.
+		template <typename TEvent>
+		class stub_event_handler : public event_handler<TEvent>
+		{
+		public:
+			virtual ~stub_event_handler() { }
+
+			virtual void on_start() { }
+			virtual void on_shutdown() { }
+			virtual void on_event(TEvent& event, int64_t sequence, bool end_of_batch) { }
+			virtual void on_timeout(int64_t sequence) { }
+			virtual void on_event_exception(const std::exception& ex, int64_t sequence, TEvent* event) { }
+			virtual void on_start_exception(const std::exception& ex) { }
+			virtual void on_shutdown_exception(const std::exception& ex) { }
+		};
+	}
+}
+
+#endif
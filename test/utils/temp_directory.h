@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2015, Alex Man-fui Lee
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of disruptor4cpp nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DISRUPTOR4CPP_TEST_UTILS_TEMP_DIRECTORY_H_
+#define DISRUPTOR4CPP_TEST_UTILS_TEMP_DIRECTORY_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include <dirent.h>
+#include <unistd.h>
+
+namespace disruptor4cpp
+{
+	namespace test
+	{
+		// A directory under /tmp that is removed, with the files in it, on destruction.
+		class temp_directory
+		{
+		public:
+			temp_directory()
+			{
+				char path_template[] = "/tmp/disruptor4cpp_XXXXXX";
+				if (::mkdtemp(path_template) == nullptr)
+					throw std::runtime_error("mkdtemp failed");
+				path_ = path_template;
+			}
+
+			~temp_directory()
+			{
+				if (DIR* dir = ::opendir(path_.c_str()))
+				{
+					while (struct dirent* entry = ::readdir(dir))
+					{
+						const std::string name(entry->d_name);
+						if (name != "." && name != "..")
+							std::remove((path_ + "/" + name).c_str());
+					}
+					::closedir(dir);
+				}
+				::rmdir(path_.c_str());
+			}
+
+			const std::string& get_path() const
+			{
+				return path_;
+			}
+
+		private:
+			temp_directory(const temp_directory&) = delete;
+			temp_directory& operator=(const temp_directory&) = delete;
+			temp_directory(temp_directory&&) = delete;
+			temp_directory& operator=(temp_directory&&) = delete;
+
+			std::string path_;
+		};
+	}
+}
+
+#endif